@@ -0,0 +1,67 @@
+/*
+ * arch/aarch32/include/asm/atomic.h - exclusive-based atomics
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ * Exclusive accesses only behave on Normal, shareable memory. Callers must make
+ * sure that the target locations are mapped accordingly.
+ */
+#ifndef __ASM_AARCH32_ATOMIC_H
+#define __ASM_AARCH32_ATOMIC_H
+
+#ifndef __ASSEMBLY__
+
+/*
+ * Atomically store @val into *@ptr and return the previous value, fully
+ * ordered.
+ */
+static inline unsigned long atomic_xchg(unsigned long *ptr, unsigned long val)
+{
+	unsigned long old, tmp;
+
+	asm volatile (
+	"	dmb	ish\n"
+	"1:	ldrex	%0, [%2]\n"
+	"	strex	%1, %3, [%2]\n"
+	"	teq	%1, #0\n"
+	"	bne	1b\n"
+	"	dmb	ish\n"
+	: "=&r" (old), "=&r" (tmp)
+	: "r" (ptr), "r" (val)
+	: "cc", "memory");
+
+	return old;
+}
+
+/*
+ * Atomically replace *@ptr with @new if it contains @old. Return the value
+ * observed in *@ptr: the swap happened if and only if it equals @old.
+ */
+static inline unsigned long atomic_cmpxchg(unsigned long *ptr,
+					   unsigned long old,
+					   unsigned long new)
+{
+	unsigned long cur, tmp;
+
+	asm volatile (
+	"	dmb	ish\n"
+	"1:	ldrex	%0, [%2]\n"
+	"	teq	%0, %3\n"
+	"	bne	2f\n"
+	"	strex	%1, %4, [%2]\n"
+	"	teq	%1, #0\n"
+	"	bne	1b\n"
+	"2:	dmb	ish\n"
+	: "=&r" (cur), "=&r" (tmp)
+	: "r" (ptr), "r" (old), "r" (new)
+	: "cc", "memory");
+
+	return cur;
+}
+
+#endif /* !__ASSEMBLY__ */
+
+#endif
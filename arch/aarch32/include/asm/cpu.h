@@ -102,6 +102,16 @@ static inline int has_gicv3_sysreg(void)
 	return !!mrc_field(ID_PFR1, GIC);
 }
 
+/* CNTPCT, in ticks of COUNTER_FREQ */
+static inline uint64_t read_counter(void)
+{
+	uint32_t lo, hi;
+
+	asm volatile("isb\n"
+		     "mrrc p15, 0, %0, %1, c14" : "=r" (lo), "=r" (hi) : : "memory");
+	return (uint64_t)hi << 32 | lo;
+}
+
 #endif /* __ASSEMBLY__ */
 
 #endif
@@ -0,0 +1,34 @@
+/*
+ * arch/aarch32/include/asm/dcc.h - Debug Communications Channel
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __ASM_AARCH32_DCC_H
+#define __ASM_AARCH32_DCC_H
+
+#include <bits.h>
+
+#ifndef __ASSEMBLY__
+
+#include <cpu.h>
+
+#define DBGDSCRint		"p14, 0, %0, c0, c1, 0"
+#define DBGDTRTXint		"p14, 0, %0, c0, c5, 0"
+
+#define DBGDSCR_TXFULL		BIT(29)
+
+/* Blocks until a debugger has read the previous character */
+static inline void dcc_putc(char c)
+{
+	while (mrc(DBGDSCRint) & DBGDSCR_TXFULL)
+		;
+
+	mcr(DBGDTRTXint, c);
+}
+
+#endif /* !__ASSEMBLY__ */
+
+#endif
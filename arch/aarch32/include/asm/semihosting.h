@@ -0,0 +1,27 @@
+/*
+ * arch/aarch32/include/asm/semihosting.h
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __ASM_AARCH32_SEMIHOSTING_H
+#define __ASM_AARCH32_SEMIHOSTING_H
+
+#ifndef __ASSEMBLY__
+
+static inline unsigned long semihosting_call(unsigned long op,
+					     unsigned long param)
+{
+	register unsigned long r0 asm("r0") = op;
+	register unsigned long r1 asm("r1") = param;
+
+	asm volatile ("svc 0x123456\n" : "+r" (r0) : "r" (r1) : "memory");
+
+	return r0;
+}
+
+#endif /* !__ASSEMBLY__ */
+
+#endif
@@ -75,10 +75,36 @@
 #define SCR_EL3_SCTLR2En		BIT(44)
 #define SCR_EL3_PIEN			BIT(45)
 #define SCR_EL3_D128En			BIT(47)
+#define SCR_EL3_AMVOFFEN		BIT(51)
 #define SCR_EL3_FGTEN2			BIT(59)
 
 #define VTCR_EL2_MSA			BIT(31)
 
+#define SCTLR_EL2_M			BIT(0)
+#define SCTLR_EL2_C			BIT(2)
+#define SCTLR_EL2_I			BIT(12)
+#define SCTLR_EL2_BR			BIT(17)
+
+#define SCTLR_EL3_M			BIT(0)
+#define SCTLR_EL3_C			BIT(2)
+#define SCTLR_EL3_ATA			BIT(43)
+
+#define TCR_EL2_RES1			(BIT(31) | BIT(23))
+#define TCR_EL2_T0SZ(bits)		(64 - (bits))
+#define TCR_EL2_PS_SHIFT		16
+
+#define TCR_EL3_RES1			(BIT(31) | BIT(23))
+#define TCR_EL3_T0SZ(bits)		(64 - (bits))
+#define TCR_EL3_PS_SHIFT		16
+
+#define MAIR_ATTR_NORMAL_NC		0x44
+#define MAIR_ATTR_NORMAL_TAGGED		0xf0
+#define MAIR_ATTR_NORMAL_WB		0xff
+#define MAIR_ATTR_DEVICE_nGnRnE		0x00
+
+#define DCZID_EL0_DZP			BIT(4)
+#define DCZID_EL0_BS			BITS(3, 0)
+
 #define HCR_EL2_RES1			BIT(1)
 #define HCR_EL2_APK			BIT(40)
 #define HCR_EL2_API			BIT(41)
@@ -92,6 +118,7 @@
 #define ID_AA64DFR0_EL1_DEBUGVER	BITS(3, 0)
 
 #define ID_AA64ISAR0_EL1_TME		BITS(27, 24)
+#define ID_AA64ISAR0_EL1_RNDR		BITS(63, 60)
 
 #define ID_AA64ISAR1_EL1_APA		BITS(7, 4)
 #define ID_AA64ISAR1_EL1_API		BITS(11, 8)
@@ -101,6 +128,7 @@
 #define ID_AA64ISAR2_EL1_GPA3		BITS(11, 8)
 #define ID_AA64ISAR2_EL1_APA3		BITS(15, 12)
 
+#define ID_AA64MMFR0_EL1_PARANGE	BITS(3, 0)
 #define ID_AA64MMFR0_EL1_MSA		BITS(51, 48)
 #define ID_AA64MMFR0_EL1_MSA_frac	BITS(55, 52)
 #define ID_AA64MMFR0_EL1_FGT		BITS(59, 56)
@@ -117,12 +145,15 @@
 #define ID_AA64MMFR3_EL1_D128		BITS(35, 32)
 
 #define ID_AA64PFR1_EL1_MTE		BITS(11, 8)
+#define ID_AA64PFR1_EL1_MPAM_frac	BITS(19, 16)
 #define ID_AA64PFR1_EL1_SME		BITS(27, 24)
 #define ID_AA64PFR1_EL1_CSV2_frac	BITS(35, 32)
 #define ID_AA64PFR1_EL1_THE		BITS(51, 48)
 
 #define ID_AA64PFR0_EL1_RAS		BITS(31, 28)
 #define ID_AA64PFR0_EL1_SVE		BITS(35, 32)
+#define ID_AA64PFR0_EL1_MPAM		BITS(43, 40)
+#define ID_AA64PFR0_EL1_AMU		BITS(47, 44)
 #define ID_AA64PFR0_EL1_CSV2		BITS(59, 56)
 
 #define ID_AA64SMFR0_EL1		s3_0_c0_c4_5
@@ -155,6 +186,7 @@
 #define SPSR_EL2H		(9 << 0)	/* EL2 Handler mode */
 #define SPSR_HYP		(0x1a << 0)	/* M[3:0] = hyp, M[4] = AArch32 */
 
+#define CPTR_EL3_TAM		(1 << 30)
 #define CPTR_EL3_ESM		(1 << 12)
 #define CPTR_EL3_EZ		(1 << 8)
 
@@ -167,6 +199,17 @@
 #define VSTCR_EL2		s3_4_c2_c6_2
 #define VSCTLR_EL2		s3_4_c2_c0_0
 
+/* Armv8-R EL2 MPU */
+#define MPUIR_EL2		s3_4_c0_c0_4
+#define PRSELR_EL2		s3_4_c6_c2_1
+#define PRBAR_EL2		s3_4_c6_c8_0
+#define PRLAR_EL2		s3_4_c6_c8_1
+
+#define MPUIR_EL2_REGION	BITS(7, 0)
+#define PRBAR_SH_INNER		(3 << 4)
+#define PRLAR_ATTRINDX(idx)	((idx) << 1)
+#define PRLAR_EN		BIT(0)
+
 #define ZCR_EL3			s3_6_c1_c2_0
 #define ZCR_EL3_LEN_MAX		0xf
 
@@ -174,6 +217,19 @@
 #define SMCR_EL3_FA64		BIT(31)
 #define SMCR_EL3_LEN_MAX	0xf
 
+#define AMCNTENSET0_EL0		s3_3_c13_c2_5
+#define AMCNTENSET0_EL0_ARCH	BITS(3, 0)
+#define AMEVCNTVOFF00_EL2	s3_4_c13_c8_0
+#define AMEVCNTVOFF02_EL2	s3_4_c13_c8_2
+#define AMEVCNTVOFF03_EL2	s3_4_c13_c8_3
+
+#define MPAM3_EL3		s3_6_c10_c5_0
+#define MPAM3_EL3_MPAMEN	BIT(63)
+#define MPAM2_EL2		s3_4_c10_c5_0
+#define MPAMHCR_EL2		s3_4_c10_c4_0
+#define MPAMIDR_EL1		s3_0_c10_c4_4
+#define MPAMIDR_EL1_HAS_HCR	BIT(17)
+
 #define ID_AA64ISAR2_EL1	s3_0_c0_c6_2
 
 #define ID_AA64MMFR3_EL1	s3_0_c0_c7_3
@@ -236,6 +292,13 @@ static inline int has_gicv3_sysreg(void)
 	return !!mrs_field(ID_AA64PFR0_EL1, GIC);
 }
 
+/* CNTPCT_EL0, in ticks of COUNTER_FREQ */
+static inline uint64_t read_counter(void)
+{
+	asm volatile("isb" : : : "memory");
+	return mrs(cntpct_el0);
+}
+
 #endif /* !__ASSEMBLY__ */
 
 #endif
@@ -0,0 +1,31 @@
+/*
+ * arch/aarch64/include/asm/dcc.h - Debug Communications Channel
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __ASM_AARCH64_DCC_H
+#define __ASM_AARCH64_DCC_H
+
+#include <bits.h>
+
+#ifndef __ASSEMBLY__
+
+#include <cpu.h>
+
+#define MDCCSR_EL0_TXFULL	BIT(29)
+
+/* Blocks until a debugger has read the previous character */
+static inline void dcc_putc(char c)
+{
+	while (mrs(mdccsr_el0) & MDCCSR_EL0_TXFULL)
+		;
+
+	msr(dbgdtrtx_el0, c);
+}
+
+#endif /* !__ASSEMBLY__ */
+
+#endif
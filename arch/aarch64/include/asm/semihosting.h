@@ -0,0 +1,27 @@
+/*
+ * arch/aarch64/include/asm/semihosting.h
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __ASM_AARCH64_SEMIHOSTING_H
+#define __ASM_AARCH64_SEMIHOSTING_H
+
+#ifndef __ASSEMBLY__
+
+static inline unsigned long semihosting_call(unsigned long op,
+					     unsigned long param)
+{
+	register unsigned long x0 asm("x0") = op;
+	register unsigned long x1 asm("x1") = param;
+
+	asm volatile ("hlt #0xf000\n" : "+r" (x0) : "r" (x1) : "memory");
+
+	return x0;
+}
+
+#endif /* !__ASSEMBLY__ */
+
+#endif
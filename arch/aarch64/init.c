@@ -11,6 +11,7 @@
 #include <gic.h>
 #include <platform.h>
 #include <stdbool.h>
+#include <tuning.h>
 
 void announce_arch(void)
 {
@@ -66,6 +67,12 @@ static bool cpu_has_scxt(void)
 	return mrs_field(ID_AA64PFR1_EL1, CSV2_frac) >= 2;
 }
 
+static bool cpu_has_mpam(void)
+{
+	return mrs_field(ID_AA64PFR0_EL1, MPAM) ||
+	       mrs_field(ID_AA64PFR1_EL1, MPAM_frac);
+}
+
 static inline bool bootwrapper_is_r_class(void)
 {
 #ifdef BOOTWRAPPER_64R
@@ -133,6 +140,9 @@ static void cpu_init_el3(void)
 	if (mrs_field(ID_AA64PFR1_EL1, THE))
 		scr |= SCR_EL3_RCWMASKEn;
 
+	if (mrs_field(ID_AA64PFR0_EL1, AMU) >= 2)
+		scr |= SCR_EL3_AMVOFFEN;
+
 	msr(SCR_EL3, scr);
 
 	msr(CPTR_EL3, cptr);
@@ -157,6 +167,20 @@ static void cpu_init_el3(void)
 
 	msr(MDCR_EL3, mdcr);
 
+	if (mrs_field(ID_AA64PFR0_EL1, AMU)) {
+		/* CPTR_EL3.TAM is clear: count from now on */
+		isb();
+
+		msr(AMCNTENSET0_EL0, AMCNTENSET0_EL0_ARCH);
+
+		/* The constant counter, 1, has no virtual offset */
+		if (mrs_field(ID_AA64PFR0_EL1, AMU) >= 2) {
+			msr(AMEVCNTVOFF00_EL2, 0);
+			msr(AMEVCNTVOFF02_EL2, 0);
+			msr(AMEVCNTVOFF03_EL2, 0);
+		}
+	}
+
 	if (mrs_field(ID_AA64PFR0_EL1, SVE)) {
 		cptr |= CPTR_EL3_EZ;
 		msr(CPTR_EL3, cptr);
@@ -188,6 +212,18 @@ static void cpu_init_el3(void)
 
 		msr(SMCR_EL3, smcr);
 	}
+
+	if (cpu_has_mpam()) {
+		/*
+		 * Enable MPAM without trapping lower ELs, which use the
+		 * default PARTID and PMG, 0, until they program their own.
+		 */
+		msr(MPAM3_EL3, MPAM3_EL3_MPAMEN);
+		msr(MPAM2_EL2, 0);
+
+		if (mrs(MPAMIDR_EL1) & MPAMIDR_EL1_HAS_HCR)
+			msr(MPAMHCR_EL2, 0);
+	}
 }
 
 void cpu_init_el2_armv8r(void)
@@ -259,6 +295,9 @@ void cpu_init_arch(unsigned int cpu)
 {
 	if (!bootwrapper_is_r_class() && mrs(CurrentEL) == CURRENTEL_EL3) {
 		cpu_init_el3();
+#ifdef CPU_TUNING
+		cpu_tune(cpu);
+#endif
 		gic_secure_init();
 	}
 
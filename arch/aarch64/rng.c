@@ -0,0 +1,207 @@
+/*
+ * arch/aarch64/rng.c - entropy for the kernel
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Without a source of entropy early on, the kernel may stall in early
+ * userspace until its CRNG is initialised. With RNG_SEED, the primary fills
+ * the rng-seed and kaslr-seed placeholders of /chosen before entering the
+ * kernel. With TRNG, PSCI also implements the SMCCC TRNG interface.
+ *
+ * The entropy comes from RNDRRS when FEAT_RNG is implemented. Otherwise, the
+ * DT seeds are folded from the CNTPCT deltas of timing uncached accesses of
+ * varying length. This is much weaker: on a model whose counter follows
+ * simulated time, it may even be the same from one boot to the next. The TRNG
+ * only ever returns RNDRRS output, and isn't available at all without it.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <boot.h>
+#include <cpu.h>
+#include <fdt.h>
+#include <platform.h>
+#include <psci.h>
+#include <rng.h>
+
+/* Size of the /chosen placeholders, in 64-bit values */
+#define RNG_SEED_VALUES		8
+#define KASLR_SEED_VALUES	1
+
+#define RNDRRS_RETRIES		16
+#define JITTER_ROUNDS		64
+#define JITTER_SCRATCH		64
+
+static bool has_rndrrs(void)
+{
+	return !!mrs_field(ID_AA64ISAR0_EL1, RNDR);
+}
+
+/* RNDRRS reseeds before each read, and may fail until it has enough entropy */
+static bool rndrrs_read(uint64_t *val)
+{
+	unsigned int i, ok;
+	uint64_t v;
+
+	for (i = 0; i < RNDRRS_RETRIES; i++) {
+		/* Sets Z on failure */
+		asm volatile("mrs	%0, s3_3_c2_c4_1\n"	/* RNDRRS */
+			     "cset	%w1, ne\n"
+			     : "=r" (v), "=r" (ok) : : "cc");
+		if (ok) {
+			*val = v;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static uint64_t mix(uint64_t pool, uint64_t val)
+{
+	pool = (pool ^ val) * 0x9e3779b97f4a7c15UL;
+
+	return pool ^ (pool >> 29);
+}
+
+static uint64_t jitter_read(void)
+{
+	static volatile unsigned long scratch[JITTER_SCRATCH];
+	uint64_t pool = mix(read_counter(), read_mpidr());
+	unsigned int i, j;
+
+	for (i = 0; i < JITTER_ROUNDS; i++) {
+		uint64_t start = read_counter();
+		unsigned int n = JITTER_SCRATCH / 4 + (pool % JITTER_SCRATCH);
+
+		for (j = 0; j < n; j++)
+			scratch[(pool + j * 7) % JITTER_SCRATCH] += j;
+
+		pool = mix(pool, read_counter() - start);
+	}
+
+	return pool;
+}
+
+/* Return true if all values came from RNDRRS */
+static bool rng_read(uint64_t *vals, unsigned int count)
+{
+	bool hw = has_rndrrs();
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		if (hw && rndrrs_read(&vals[i]))
+			continue;
+
+		hw = false;
+		vals[i] = jitter_read();
+	}
+
+	return hw;
+}
+
+#ifdef RNG_SEED
+void rng_seed_dt(void)
+{
+	uint64_t rng_seed[RNG_SEED_VALUES];
+	uint64_t kaslr_seed[KASLR_SEED_VALUES];
+	bool hw;
+
+	hw = rng_read(rng_seed, RNG_SEED_VALUES);
+	hw &= rng_read(kaslr_seed, KASLR_SEED_VALUES);
+
+	if (fdt_set_prop_u64s(&dtb, "/chosen", "rng-seed", rng_seed,
+			      RNG_SEED_VALUES) ||
+	    fdt_set_prop_u64s(&dtb, "/chosen", "kaslr-seed", kaslr_seed,
+			      KASLR_SEED_VALUES)) {
+		print_string("RNG: cannot seed the DT\r\n");
+		return;
+	}
+
+	print_string(hw ? "RNG: seeded the DT from RNDRRS\r\n" :
+			  "RNG: seeded the DT from counter jitter\r\n");
+}
+#endif
+
+#ifdef TRNG
+/* Identifies the TRNG back-end: 7f3b2a4e-91c6-4d85-a0e2-5b6c18d9f034 */
+static const uint32_t trng_uuid[4] = {
+	0x4e2a3b7f, 0x854dc691, 0x6c5be2a0, 0x34f0d918,
+};
+
+/* Callers only probe TRNG_VERSION: once it succeeds, RND must work */
+long trng_version(void)
+{
+	return has_rndrrs() ? TRNG_VERSION_VALUE : PSCI_RET_NOT_SUPPORTED;
+}
+
+long trng_features(unsigned long fid)
+{
+	if (!has_rndrrs())
+		return PSCI_RET_NOT_SUPPORTED;
+
+	switch (fid) {
+	case TRNG_VERSION:
+	case TRNG_FEATURES:
+	case TRNG_GET_UUID:
+	case TRNG_RND_32:
+	case TRNG_RND_64:
+		return PSCI_RET_SUCCESS;
+	default:
+		return PSCI_RET_NOT_SUPPORTED;
+	}
+}
+
+long trng_get_uuid(unsigned long *res)
+{
+	res[0] = trng_uuid[1];
+	res[1] = trng_uuid[2];
+	res[2] = trng_uuid[3];
+
+	return trng_uuid[0];
+}
+
+/*
+ * Return @bits of entropy in res[0..2], x1 to x3, of @reg_bits each. The
+ * least significant bits are in x3, and those above @bits are zero.
+ */
+long trng_rnd(unsigned long bits, unsigned int reg_bits, unsigned long *res)
+{
+	uint64_t vals[3];
+	unsigned int i;
+
+	/* SMC32 callers may leave junk in the top half of x1 */
+	if (reg_bits < 64)
+		bits &= (UL(1) << reg_bits) - 1;
+	if (!bits || bits > 3 * reg_bits)
+		return PSCI_RET_INVALID_PARAMETERS;
+
+	if (!has_rndrrs())
+		return PSCI_RET_NOT_SUPPORTED;
+
+	/* Never jitter: the caller expects full entropy */
+	for (i = 0; i < 3; i++)
+		if (!rndrrs_read(&vals[i]))
+			return TRNG_RET_NO_ENTROPY;
+
+	for (i = 0; i < 3; i++) {
+		unsigned int lsb = (2 - i) * reg_bits;
+		uint64_t val = vals[i];
+
+		if (reg_bits < 64)
+			val &= (UL(1) << reg_bits) - 1;
+		if (bits <= lsb)
+			val = 0;
+		else if (bits - lsb < reg_bits)
+			val &= (UL(1) << (bits - lsb)) - 1;
+
+		res[i] = val;
+	}
+
+	return PSCI_RET_SUCCESS;
+}
+#endif
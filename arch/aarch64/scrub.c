@@ -0,0 +1,314 @@
+/*
+ * arch/aarch64/scrub.c - zero memory and its allocation tags before boot
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Once cpu_init_bootwrapper() has gathered them, all CPUs zero the memory
+ * banks in parallel, minus the objects placed there by the boot-wrapper. Each
+ * CPU takes an equal, page-aligned stripe of every range.
+ *
+ * DC ZVA faults on the Device memory that all accesses are with the MMU off,
+ * so each CPU enables a temporary identity map for the duration of the scrub,
+ * made of 1GB blocks of Normal memory. When MTE is implemented the memory is
+ * Tagged, and DC GZVA zeroes the allocation tags as well.
+ *
+ * Pages that the boot-wrapper's objects only partly cover are left alone.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpu.h>
+#include <fdt.h>
+#include <platform.h>
+#include <scrub.h>
+
+#define PAGE_SIZE		UL(0x1000)
+#define BLOCK_SHIFT		30
+#define BLOCK_SIZE		(UL(1) << BLOCK_SHIFT)
+#define VA_BITS			39
+#define NR_BLOCKS		(UL(1) << (VA_BITS - BLOCK_SHIFT))
+#define VA_LIMIT		(NR_BLOCKS * BLOCK_SIZE)
+
+#define PTE_BLOCK		BIT(0)
+#define PTE_ATTRINDX(idx)	((idx) << 2)
+#define PTE_SH_INNER		(UL(3) << 8)
+#define PTE_AF			BIT(10)
+
+#define SCRUB_MAX_EXCLUDED	12
+#define SCRUB_PROP		"boot-wrapper,zeroed-memory"
+
+struct scrub_range {
+	unsigned long start;
+	unsigned long end;
+};
+
+static const unsigned long scrub_banks[] = { SCRUB_BANKS };
+
+#define NR_SCRUB_BANKS		(sizeof(scrub_banks) / sizeof(scrub_banks[0]) / 2)
+
+static uint64_t page_table[NR_BLOCKS] __attribute__((aligned(PAGE_SIZE)));
+
+static struct scrub_range excluded[SCRUB_MAX_EXCLUDED];
+static unsigned int nr_excluded;
+static struct scrub_range ranges[SCRUB_MAX_RANGES];
+static unsigned int nr_ranges;
+
+static bool scrub_enabled;
+static bool scrub_tags;
+static unsigned long scrub_sctlr;
+static unsigned long scrub_start;
+
+static volatile bool scrub_ready;
+static volatile bool scrub_done[NR_CPUS];
+
+extern unsigned long dtb;
+
+void scrub_range(unsigned long start, unsigned long end, unsigned long sctlr,
+		 unsigned long tags);
+
+static void exclude(unsigned long start, unsigned long end)
+{
+	unsigned int i;
+
+	if (start == end)
+		return;
+
+	/* Keep them sorted */
+	for (i = nr_excluded; i > 0 && excluded[i - 1].start > start; i--)
+		excluded[i] = excluded[i - 1];
+
+	excluded[i].start = start;
+	excluded[i].end = end;
+	nr_excluded++;
+}
+
+#define exclude_object(object)					\
+do {								\
+	extern char object##__start[];				\
+	extern char object##__end[];				\
+	exclude((unsigned long)object##__start,			\
+		(unsigned long)object##__end);			\
+} while (0)
+
+static void exclude_objects(void)
+{
+	exclude_object(text);
+	exclude_object(mbox);
+	exclude_object(bss);
+	exclude_object(stack);
+	exclude_object(kernel);
+#ifdef XEN
+	exclude_object(xen);
+#endif
+	exclude_object(dtb);
+#ifdef USE_INITRD
+	exclude_object(filesystem);
+#endif
+#ifdef BOOTLOG
+	exclude_object(bootlog);
+#endif
+#ifdef SYSTEM_RESET
+	exclude_object(snapshot);
+#endif
+#ifdef SMC_STATS
+	exclude_object(smc_stats);
+#endif
+}
+
+static void add_range(unsigned long start, unsigned long end)
+{
+	start = (start + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+	end &= ~(PAGE_SIZE - 1);
+
+	if (start >= end)
+		return;
+
+	if (end > VA_LIMIT) {
+		print_string("Scrub: memory above ");
+		print_ulong_hex(VA_LIMIT);
+		print_string(" is left alone\r\n");
+		if (start >= VA_LIMIT)
+			return;
+		end = VA_LIMIT;
+	}
+
+	if (nr_ranges == SCRUB_MAX_RANGES) {
+		print_string("Scrub: too many ranges, ignoring ");
+		print_ulong_hex(start);
+		print_string("\r\n");
+		return;
+	}
+
+	ranges[nr_ranges].start = start;
+	ranges[nr_ranges].end = end;
+	nr_ranges++;
+}
+
+static void map_block(unsigned long addr, unsigned long attrs)
+{
+	unsigned long idx = addr >> BLOCK_SHIFT;
+
+	page_table[idx] = (idx << BLOCK_SHIFT) | attrs;
+}
+
+/*
+ * Work out what to zero and build the identity map. Only the blocks covering
+ * the ranges and the boot-wrapper's code are mapped.
+ */
+static bool scrub_prepare(void)
+{
+	extern char text__start[];
+	unsigned long attrs, addr;
+	unsigned int i, j;
+
+	if (mrs(CurrentEL) != CURRENTEL_EL3) {
+		print_string("Scrub: not booted at EL3, memory left alone\r\n");
+		return false;
+	}
+
+	if (mrs(dczid_el0) & DCZID_EL0_DZP) {
+		print_string("Scrub: DC ZVA prohibited, memory left alone\r\n");
+		return false;
+	}
+
+	exclude_objects();
+
+	for (i = 0; i < NR_SCRUB_BANKS; i++) {
+		unsigned long cur = scrub_banks[2 * i];
+		unsigned long end = cur + scrub_banks[2 * i + 1];
+
+		for (j = 0; j < nr_excluded; j++) {
+			if (excluded[j].end <= cur || excluded[j].start >= end)
+				continue;
+			add_range(cur, excluded[j].start);
+			cur = excluded[j].end;
+		}
+
+		add_range(cur, end);
+	}
+
+	if (!nr_ranges)
+		return false;
+
+	scrub_tags = mrs_field(ID_AA64PFR1_EL1, MTE) >= 2;
+
+	attrs = PTE_AF | PTE_SH_INNER | PTE_ATTRINDX(0) | PTE_BLOCK;
+	for (i = 0; i < NR_BLOCKS; i++)
+		page_table[i] = 0;
+	for (i = 0; i < nr_ranges; i++) {
+		for (addr = ranges[i].start; addr < ranges[i].end; addr += BLOCK_SIZE)
+			map_block(addr, attrs);
+		map_block(ranges[i].end - 1, attrs);
+	}
+	map_block((unsigned long)text__start, attrs);
+
+	scrub_sctlr = mrs(sctlr_el3) | SCTLR_EL3_M;
+	if (scrub_tags)
+		scrub_sctlr |= SCTLR_EL3_C | SCTLR_EL3_ATA;
+
+	return true;
+}
+
+static void scrub_stripes(unsigned int cpu)
+{
+	unsigned int i;
+
+	msr(mair_el3, scrub_tags ? MAIR_ATTR_NORMAL_TAGGED : MAIR_ATTR_NORMAL_NC);
+	/* Non-cacheable walks: the table was written with the MMU off */
+	msr(tcr_el3, TCR_EL3_RES1 | TCR_EL3_T0SZ(VA_BITS) |
+		     mrs_field(ID_AA64MMFR0_EL1, PARANGE) << TCR_EL3_PS_SHIFT);
+	msr(ttbr0_el3, (unsigned long)page_table);
+	isb();
+	asm volatile ("tlbi alle3" : : : "memory");
+	dsb(nsh);
+	isb();
+
+	for (i = 0; i < nr_ranges; i++) {
+		unsigned long start = ranges[i].start;
+		unsigned long pages = (ranges[i].end - start) / PAGE_SIZE;
+
+		scrub_range(start + pages * cpu / NR_CPUS * PAGE_SIZE,
+			    start + pages * (cpu + 1) / NR_CPUS * PAGE_SIZE,
+			    scrub_sctlr, scrub_tags);
+	}
+}
+
+static void scrub_report(void)
+{
+	unsigned long ticks = read_counter() - scrub_start;
+	unsigned long us = ticks * 1000000 / COUNTER_FREQ;
+	unsigned long bytes = 0;
+	uint64_t vals[2 * SCRUB_MAX_RANGES];
+	unsigned int i;
+
+	for (i = 0; i < nr_ranges; i++) {
+		bytes += ranges[i].end - ranges[i].start;
+		vals[2 * i] = ranges[i].start;
+		vals[2 * i + 1] = ranges[i].end - ranges[i].start;
+	}
+
+	print_string("Scrubbed ");
+	print_ulong_dec(bytes >> 20);
+	print_string(scrub_tags ? " MiB and tags in " : " MiB in ");
+	print_ulong_dec(us);
+	print_string("us (");
+	print_ulong_dec(us * (UL(1) << 30) / bytes);
+	print_string("us/GiB)\r\n");
+
+	if (fdt_set_prop_u64s(&dtb, "/chosen", SCRUB_PROP, vals, nr_ranges))
+		print_string("Scrub: cannot record the zeroed ranges in the DT\r\n");
+
+	/*
+	 * With Tagged memory, the map was cacheable: discard any line of the
+	 * boot-wrapper's objects that got speculatively allocated, as these
+	 * are still written with the MMU off.
+	 */
+	if (scrub_tags) {
+		for (i = 0; i < nr_excluded; i++)
+			dcache_clean_inval_range(excluded[i].start,
+						 excluded[i].end);
+	}
+}
+
+/*
+ * Called by every CPU once all of them are initialised. The primary prepares,
+ * waits for everyone to finish and reports.
+ */
+void scrub_memory(unsigned int cpu)
+{
+	unsigned int i;
+
+	if (cpu == 0) {
+		scrub_enabled = scrub_prepare();
+		scrub_start = read_counter();
+		dsb(sy);
+		scrub_ready = true;
+		dsb(sy);
+		sev();
+	} else {
+		while (!scrub_ready)
+			wfe();
+	}
+
+	if (scrub_enabled)
+		scrub_stripes(cpu);
+
+	scrub_done[cpu] = true;
+	dsb(sy);
+	sev();
+
+	if (cpu != 0)
+		return;
+
+	for (i = 0; i < NR_CPUS; i++) {
+		while (!scrub_done[i])
+			wfe();
+	}
+
+	if (scrub_enabled)
+		scrub_report();
+}
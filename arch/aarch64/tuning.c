@@ -0,0 +1,227 @@
+/*
+ * arch/aarch64/tuning.c - per-core IMPLEMENTATION DEFINED settings
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Each entry of the table sets and clears bits in one register, on the cores
+ * whose MIDR_EL1 has its implementer and part number, and a variant and
+ * revision within its range. Every matching entry is applied in order, at EL3
+ * before the caches are used, and logged the first time each CPU boots. With
+ * EARLY_HANDOFF, only the primary's entries are logged.
+ *
+ * The built-in entries only cover what doesn't depend on the SoC around the
+ * core. A file of more entries can be given with --with-cpu-tuning=<file>; it
+ * is included after them, so it can also undo them. For instance:
+ *
+ *	TUNE(MIDR_CORTEX_A72, REV(0, 0), REV(0, 3), CPUACTLR_A57, BIT(n), 0, "desc"),
+ */
+#include <stdbool.h>
+
+#include <cpu.h>
+#include <platform.h>
+#include <tuning.h>
+
+#define MIDR_PART_MASK		0xff0ffff0
+#define MIDR_ARM(part)		(0x410f0000 | ((part) << 4))
+
+#define MIDR_CORTEX_A53		MIDR_ARM(0xd03)
+#define MIDR_CORTEX_A35		MIDR_ARM(0xd04)
+#define MIDR_CORTEX_A55		MIDR_ARM(0xd05)
+#define MIDR_CORTEX_A57		MIDR_ARM(0xd07)
+#define MIDR_CORTEX_A72		MIDR_ARM(0xd08)
+#define MIDR_CORTEX_A73		MIDR_ARM(0xd09)
+#define MIDR_CORTEX_A75		MIDR_ARM(0xd0a)
+#define MIDR_CORTEX_A76		MIDR_ARM(0xd0b)
+#define MIDR_NEOVERSE_N1	MIDR_ARM(0xd0c)
+
+/* rXpY, as MIDR_EL1's variant and revision fields */
+#define REV(x, y)		(((x) << 4) | (y))
+#define REV_FIRST		REV(0, 0)
+#define REV_LAST		REV(15, 15)
+
+/*
+ * The registers are named after the first core to use their encoding:
+ * _A57 for the Cortex-A35/A53/A57/A72/A73, _A76 for DynamIQ cores.
+ */
+enum tuning_reg {
+	TUNE_ACTLR_EL3,
+	TUNE_ACTLR_EL2,
+	TUNE_CPUACTLR_A57,
+	TUNE_CPUECTLR_A57,
+	TUNE_CPUACTLR_A76,
+	TUNE_CPUECTLR_A76,
+};
+
+static const char * const tuning_reg_names[] = {
+	[TUNE_ACTLR_EL3]	= "ACTLR_EL3",
+	[TUNE_ACTLR_EL2]	= "ACTLR_EL2",
+	[TUNE_CPUACTLR_A57]	= "CPUACTLR_EL1",
+	[TUNE_CPUECTLR_A57]	= "CPUECTLR_EL1",
+	[TUNE_CPUACTLR_A76]	= "CPUACTLR_EL1",
+	[TUNE_CPUECTLR_A76]	= "CPUECTLR_EL1",
+};
+
+#define CPUACTLR_A57		s3_1_c15_c2_0
+#define CPUECTLR_A57		s3_1_c15_c2_1
+#define CPUACTLR_A76		s3_0_c15_c1_0
+#define CPUECTLR_A76		s3_0_c15_c1_4
+
+/* Whether lower ELs may access CPUECTLR_EL1 */
+#define ACTLR_CPUECTLR		BIT(1)
+
+#define CPUECTLR_A57_SMPEN	BIT(6)
+
+struct tuning {
+	unsigned long midr;
+	unsigned int rev_min;
+	unsigned int rev_max;
+	enum tuning_reg reg;
+	unsigned long set;
+	unsigned long clear;
+	const char *desc;
+};
+
+#define TUNE(_midr, _rev_min, _rev_max, _reg, _set, _clear, _desc)	\
+	{								\
+		.midr = _midr,						\
+		.rev_min = _rev_min,					\
+		.rev_max = _rev_max,					\
+		.reg = TUNE_##_reg,					\
+		.set = _set,						\
+		.clear = _clear,					\
+		.desc = _desc,						\
+	}
+
+#define TUNE_DELEGATE_ECTLR(midr)					\
+	TUNE(midr, REV_FIRST, REV_LAST, ACTLR_EL3, ACTLR_CPUECTLR, 0,	\
+	     "CPUECTLR_EL1 access at EL2"),				\
+	TUNE(midr, REV_FIRST, REV_LAST, ACTLR_EL2, ACTLR_CPUECTLR, 0,	\
+	     "CPUECTLR_EL1 access at EL1")
+
+/*
+ * Without SMPEN, the Cortex-A35/A53/A57/A72/A73 don't take part in coherency,
+ * and must not enable their caches.
+ */
+#define TUNE_SMPEN(midr)						\
+	TUNE(midr, REV_FIRST, REV_LAST, CPUECTLR_A57, CPUECTLR_A57_SMPEN, 0,	\
+	     "SMPEN")
+
+static const struct tuning tuning_table[] = {
+	TUNE_SMPEN(MIDR_CORTEX_A35),
+	TUNE_SMPEN(MIDR_CORTEX_A53),
+	TUNE_SMPEN(MIDR_CORTEX_A57),
+	TUNE_SMPEN(MIDR_CORTEX_A72),
+	TUNE_SMPEN(MIDR_CORTEX_A73),
+
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A35),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A53),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A55),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A57),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A72),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A73),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A75),
+	TUNE_DELEGATE_ECTLR(MIDR_CORTEX_A76),
+	TUNE_DELEGATE_ECTLR(MIDR_NEOVERSE_N1),
+
+#ifdef CPU_TUNING_TABLE
+#include CPU_TUNING_TABLE
+#endif
+};
+
+#define NR_TUNINGS		(sizeof(tuning_table) / sizeof(tuning_table[0]))
+
+/* Only the first boot is logged: CPUs powered back up by PSCI stay quiet */
+static bool tuned[NR_CPUS];
+
+static unsigned long read_tuning_reg(enum tuning_reg reg)
+{
+	switch (reg) {
+	case TUNE_ACTLR_EL3:
+		return mrs(ACTLR_EL3);
+	case TUNE_ACTLR_EL2:
+		return mrs(ACTLR_EL2);
+	case TUNE_CPUACTLR_A57:
+		return mrs(CPUACTLR_A57);
+	case TUNE_CPUECTLR_A57:
+		return mrs(CPUECTLR_A57);
+	case TUNE_CPUACTLR_A76:
+		return mrs(CPUACTLR_A76);
+	case TUNE_CPUECTLR_A76:
+		return mrs(CPUECTLR_A76);
+	}
+
+	return 0;
+}
+
+static void write_tuning_reg(enum tuning_reg reg, unsigned long val)
+{
+	switch (reg) {
+	case TUNE_ACTLR_EL3:
+		msr(ACTLR_EL3, val);
+		break;
+	case TUNE_ACTLR_EL2:
+		msr(ACTLR_EL2, val);
+		break;
+	case TUNE_CPUACTLR_A57:
+		msr(CPUACTLR_A57, val);
+		break;
+	case TUNE_CPUECTLR_A57:
+		msr(CPUECTLR_A57, val);
+		break;
+	case TUNE_CPUACTLR_A76:
+		msr(CPUACTLR_A76, val);
+		break;
+	case TUNE_CPUECTLR_A76:
+		msr(CPUECTLR_A76, val);
+		break;
+	}
+}
+
+static void log_tuning(unsigned int cpu, const struct tuning *t,
+		       unsigned long old, unsigned long new)
+{
+#ifdef EARLY_HANDOFF
+	/* The kernel may own the console by now, as in cpu_init_self() */
+	if (cpu != 0)
+		return;
+#endif
+
+	print_cpu_msg(cpu, tuning_reg_names[t->reg]);
+	print_string(" ");
+	print_ulong_hex(old);
+	print_string(" -> ");
+	print_ulong_hex(new);
+	print_string(" (");
+	print_string(t->desc);
+	print_string(")\r\n");
+}
+
+void cpu_tune(unsigned int cpu)
+{
+	unsigned long midr = mrs(midr_el1);
+	unsigned int rev = REV((midr >> 20) & 0xf, midr & 0xf);
+	unsigned int i;
+
+	for (i = 0; i < NR_TUNINGS; i++) {
+		const struct tuning *t = &tuning_table[i];
+		unsigned long old, new;
+
+		if ((midr & MIDR_PART_MASK) != t->midr ||
+		    rev < t->rev_min || rev > t->rev_max)
+			continue;
+
+		old = read_tuning_reg(t->reg);
+		new = (old & ~t->clear) | t->set;
+		write_tuning_reg(t->reg, new);
+
+		if (!tuned[cpu])
+			log_tuning(cpu, t, old, new);
+	}
+
+	isb();
+	tuned[cpu] = true;
+}
@@ -0,0 +1,204 @@
+/*
+ * xip.c - execute in place from flash
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * The boot-wrapper's code and read-only data run from flash at XIP_BASE. Its
+ * .data, the mbox and the payloads are linked at their DRAM addresses, and
+ * stored in flash after the code, see model.lds.S.
+ *
+ * The primary CPU copies .data and the mbox before anything uses them, and
+ * the secondaries wait for it. This happens whenever a CPU comes out of reset,
+ * except when the FVP power controller reports that PSCI powered it back up:
+ * the contents of DRAM can't tell a warm boot from a stale one. Then all CPUs
+ * copy the payloads, each taking one stripe of every payload, so that the copy
+ * isn't bound by a single CPU's bandwidth to flash.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpu.h>
+#include <platform.h>
+#include <xip.h>
+
+/* "XIPD", left in DRAM once .data is in place */
+#define XIP_DATA_MAGIC		0x44504958
+
+/* Stripes are whole cache lines, so that no two CPUs share one */
+#define XIP_STRIPE_ALIGN	64
+
+struct xip_region {
+	char *start;
+	char *end;
+	const char *load;
+};
+
+#define XIP_REGION(object)					\
+	{ object##__start, object##__end, object##__load }
+
+extern char data__start[], data__end[], data__load[];
+extern char mbox__start[], mbox__end[], mbox__load[];
+extern char kernel__start[], kernel__end[], kernel__load[];
+extern char xen__start[], xen__end[], xen__load[];
+extern char dtb__start[], dtb__end[], dtb__load[];
+extern char filesystem__start[], filesystem__end[], filesystem__load[];
+
+static const struct xip_region data_regions[] = {
+	XIP_REGION(data),
+	XIP_REGION(mbox),
+};
+
+#define NR_DATA_REGIONS		(sizeof(data_regions) / sizeof(data_regions[0]))
+
+static const struct xip_region payload_regions[] = {
+	XIP_REGION(kernel),
+#ifdef XEN
+	XIP_REGION(xen),
+#endif
+	XIP_REGION(dtb),
+#ifdef USE_INITRD
+	XIP_REGION(filesystem),
+#endif
+};
+
+#define NR_PAYLOAD_REGIONS	(sizeof(payload_regions) / sizeof(payload_regions[0]))
+
+/*
+ * Not in .data, which it guards, nor in .bss, which the primary zeroes. Only
+ * the secondaries rely on it, and only during a cold boot: the primary clears
+ * it once all CPUs are done copying, so that DRAM kept across a reset doesn't
+ * hold it. DRAM mustn't hold it at power-on.
+ */
+static volatile uint32_t xip_data_ready __attribute__((section(".xip")));
+
+/* In .bss: only used once .data is in place and .bss zeroed */
+static volatile bool xip_copied[NR_CPUS];
+
+/*
+ * With the MMU off every access is Device, which must be aligned: copy pairs
+ * of words, then the remaining bytes. Regions and stripes start on a 16-byte
+ * boundary.
+ */
+static void copy(char *dst, const char *src, unsigned long size)
+{
+	unsigned long i;
+
+	for (i = 0; i + 2 * sizeof(long) <= size; i += 2 * sizeof(long)) {
+		unsigned long a = *(const unsigned long *)(src + i);
+		unsigned long b = *(const unsigned long *)(src + i + sizeof(long));
+
+		*(unsigned long *)(dst + i) = a;
+		*(unsigned long *)(dst + i + sizeof(long)) = b;
+	}
+
+	for (; i < size; i++)
+		dst[i] = src[i];
+}
+
+static void copy_region(const struct xip_region *region)
+{
+	copy(region->start, region->load, region->end - region->start);
+}
+
+void xip_copy_data(void)
+{
+	unsigned int i;
+
+#ifdef FVP_PWRC_BASE
+	/* Powered back up by PSCI: .data is live, and mustn't be reloaded */
+	if (platform_cpu_woken())
+		return;
+#endif
+
+	if (this_cpu_logical_id() != 0) {
+		while (xip_data_ready != XIP_DATA_MAGIC)
+			wfe();
+		dmb(sy);
+		return;
+	}
+
+	xip_data_ready = 0;
+	dsb(sy);
+
+	for (i = 0; i < NR_DATA_REGIONS; i++)
+		copy_region(&data_regions[i]);
+
+	dsb(sy);
+	xip_data_ready = XIP_DATA_MAGIC;
+	dsb(sy);
+	sev();
+}
+
+static void copy_stripe(const struct xip_region *region, unsigned int cpu)
+{
+	unsigned long size = region->end - region->start;
+	unsigned long stripe, start, end;
+
+	stripe = (size + NR_CPUS - 1) / NR_CPUS;
+	stripe = (stripe + XIP_STRIPE_ALIGN - 1) & ~(XIP_STRIPE_ALIGN - 1UL);
+
+	start = cpu * stripe;
+	end = start + stripe;
+	if (start >= size)
+		return;
+	if (end > size)
+		end = size;
+
+	copy(region->start + start, region->load + start, end - start);
+}
+
+static void print_bandwidth(unsigned long bytes, uint64_t ticks)
+{
+	print_string("XIP: copied ");
+	print_ulong_dec(bytes);
+	print_string(" bytes of payloads to DRAM in ");
+	print_ulong_dec(ticks * 1000000 / COUNTER_FREQ);
+	print_string("us");
+
+	if (ticks) {
+		print_string(" (");
+		print_ulong_dec(bytes * COUNTER_FREQ / ticks / 1024);
+		print_string("KiB/s)");
+	}
+
+	print_string("\r\n");
+}
+
+/*
+ * Called by every CPU on cold boot. The primary returns once all payloads
+ * are in place.
+ */
+void xip_copy_payloads(unsigned int cpu)
+{
+	uint64_t start = read_counter();
+	unsigned long bytes = 0;
+	unsigned int i;
+
+	for (i = 0; i < NR_PAYLOAD_REGIONS; i++)
+		copy_stripe(&payload_regions[i], cpu);
+
+	dsb(sy);
+	xip_copied[cpu] = true;
+	dsb(sy);
+	sev();
+
+	if (cpu != 0)
+		return;
+
+	for (i = 0; i < NR_CPUS; i++)
+		while (!xip_copied[i])
+			wfe();
+
+	/* Every secondary is past xip_copy_data() */
+	xip_data_ready = 0;
+	dsb(sy);
+
+	for (i = 0; i < NR_PAYLOAD_REGIONS; i++)
+		bytes += payload_regions[i].end - payload_regions[i].start;
+
+	print_bandwidth(bytes, read_counter() - start);
+}
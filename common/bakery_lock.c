@@ -28,8 +28,9 @@
  * 2) Storage of number[k] allows it to become large enough for practical use of
  *    the lock. Indeed, if the lock is contended all of the time, the value of
  *    max(number[1..N]) will keep increasing, and this algorithm doesn't handle
- *    wrapping of the ticket number. In this implementation, we assume that we
- *    will never reach 32766 (0x7fff) overlapping calls to bakery_lock.
+ *    wrapping of the ticket number. In this implementation, a CPU that would
+ *    draw a number beyond BAKERY_NUMBER_MAX backs off in the doorway until the
+ *    current holders drain, instead of wrapping.
  *
  * [1] Lamport, L. "A New Solution of Dijkstra's Concurrent Programming Problem"
  */
@@ -74,6 +75,8 @@ static unsigned int choose_number(bakery_ticket_t *tickets, unsigned self)
  * @tickets: array of size NR_CPUS, indexed by logical IDs.
  * @self:    logical ID of the current CPU
  *
+ * Returns the number of times the doorway backed off for lack of numbers.
+ *
  * Note: since this implementation assumes that all loads and stores to tickets
  * are of Device type with non-gathering and non-reordering attributes, we
  * expect all of them to be performed, in program order. As a result, the
@@ -81,14 +84,30 @@ static unsigned int choose_number(bakery_ticket_t *tickets, unsigned self)
  * synchronize before sev(), and introduce system-wide memory barriers around
  * the critical section.
  */
-void bakery_lock(bakery_ticket_t *tickets, unsigned self)
+unsigned int bakery_lock(bakery_ticket_t *tickets, unsigned self)
 {
 	int cpu, number_self;
 	bakery_ticket_t ticket;
+	unsigned int backoffs = 0;
 
 	/* Doorway */
-	write_ticket_once(tickets[self], 1, 0);
-	number_self = choose_number(tickets, self);
+	for (;;) {
+		write_ticket_once(tickets[self], 1, 0);
+		number_self = choose_number(tickets, self);
+		if (number_self <= BAKERY_NUMBER_MAX)
+			break;
+
+		/*
+		 * Out of numbers: step back and let the CPUs that already hold
+		 * one go through. Each of them resets its number to zero on
+		 * unlock, so the maximum eventually drops.
+		 */
+		write_ticket_once(tickets[self], 0, 0);
+		dsb(st);
+		sev();
+		wfe();
+		backoffs++;
+	}
 	write_ticket_once(tickets[self], 0, number_self);
 
 	dsb(st);
@@ -124,6 +143,8 @@ void bakery_lock(bakery_ticket_t *tickets, unsigned self)
 	}
 
 	dmb(sy);
+
+	return backoffs;
 }
 
 void bakery_unlock(bakery_ticket_t *tickets, unsigned self)
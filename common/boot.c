@@ -8,15 +8,7 @@
  */
 #include <boot.h>
 #include <cpu.h>
-
-extern unsigned long entrypoint;
-extern unsigned long dtb;
-
-void __noreturn jump_kernel(unsigned long address,
-			    unsigned long a0,
-			    unsigned long a1,
-			    unsigned long a2,
-			    unsigned long a3);
+#include <partition.h>
 
 const unsigned long id_table[] = { CPU_IDS };
 
@@ -29,12 +21,14 @@ const unsigned long id_table[] = { CPU_IDS };
  */
 void __noreturn spin(unsigned long *mbox, unsigned long invalid)
 {
-	unsigned long addr = invalid;
+	unsigned long addr;
 
-	while (addr == invalid) {
+	/*
+	 * Check before waiting: the release may have happened, and its event
+	 * been consumed, before we got here.
+	 */
+	while ((addr = *mbox) == invalid)
 		wfe();
-		addr = *mbox;
-	}
 
 	jump_kernel(addr, 0, 0, 0, 0);
 
@@ -53,14 +47,23 @@ void __noreturn first_spin(unsigned int cpu, unsigned long *mbox,
 			   unsigned long invalid)
 {
 	if (cpu == 0) {
-		unsigned long addr = (unsigned long)&entrypoint;
+		unsigned long addr = kernel_entrypoint();
 #ifdef KERNEL_32
 		jump_kernel(addr, 0, ~0, (unsigned long)&dtb, 0);
 #else
 		jump_kernel(addr, (unsigned long)&dtb, 0, 0, 0);
 #endif
 	} else {
+#ifdef PARTITIONS
+		/* The first CPU of each other partition boots its kernel */
+		if (partition_is_boot_cpu(cpu))
+			jump_kernel(partition_entrypoint(cpu),
+				    partition_dtb(cpu), 0, 0, 0);
+#endif
+#ifndef EARLY_HANDOFF
+		/* Not with early handoff: the kernel may have released us */
 		*mbox = invalid;
+#endif
 		spin(mbox, invalid);
 	}
 
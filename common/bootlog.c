@@ -0,0 +1,57 @@
+/*
+ * bootlog.c - in-memory boot log
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Keeps a copy of everything printed in a ring buffer, which the generated DT
+ * describes as a ramoops region with a single console record. The layout is
+ * the one of the kernel's persistent_ram_buffer, so that after boot the log
+ * can be read from /sys/fs/pstore/console-ramoops-0.
+ *
+ * Only one CPU prints at a time during boot, so the ring isn't locked.
+ */
+#include <stdint.h>
+
+#include <bootlog.h>
+
+/* "DBGC", the signature of a persistent RAM buffer without ECC */
+#define BOOTLOG_SIG		0x43474244
+
+struct bootlog_buffer {
+	uint32_t	sig;
+	/* Offset of the next byte to write */
+	uint32_t	start;
+	/* Number of valid bytes, ending at start */
+	uint32_t	size;
+	uint8_t		data[];
+};
+
+#define BOOTLOG_DATA_SIZE	(BOOTLOG_SIZE - sizeof(struct bootlog_buffer))
+
+/* Provided by the linker script */
+extern volatile struct bootlog_buffer bootlog;
+
+void bootlog_init(void)
+{
+	bootlog.start = 0;
+	bootlog.size = 0;
+	bootlog.sig = BOOTLOG_SIG;
+}
+
+void bootlog_putc(char c)
+{
+	uint32_t start = bootlog.start;
+
+	bootlog.data[start] = c;
+
+	if (++start == BOOTLOG_DATA_SIZE)
+		start = 0;
+	bootlog.start = start;
+
+	if (bootlog.size < BOOTLOG_DATA_SIZE)
+		bootlog.size++;
+}
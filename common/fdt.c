@@ -0,0 +1,213 @@
+/*
+ * fdt.c - minimal flattened device tree access
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Only finds existing properties so that their value can be updated in place.
+ * Properties whose value is only known at boot are given a placeholder of the
+ * right size when the DT is generated, which keeps the blob's layout fixed.
+ *
+ * With the MMU off, all accesses must be aligned: the header and structure
+ * block are read 32 bits at a time, names byte by byte.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <fdt.h>
+
+#define FDT_MAGIC		0xd00dfeed
+
+#define FDT_BEGIN_NODE		0x1
+#define FDT_END_NODE		0x2
+#define FDT_PROP		0x3
+#define FDT_NOP			0x4
+#define FDT_END			0x9
+
+struct fdt_header {
+	uint32_t magic;
+	uint32_t totalsize;
+	uint32_t off_dt_struct;
+	uint32_t off_dt_strings;
+	uint32_t off_mem_rsvmap;
+	uint32_t version;
+	uint32_t last_comp_version;
+	uint32_t boot_cpuid_phys;
+	uint32_t size_dt_strings;
+	uint32_t size_dt_struct;
+};
+
+#define fdt32(val)	__builtin_bswap32(val)
+
+/* Length of a string including its terminator, rounded up to a token */
+static uint32_t token_len(const char *str)
+{
+	uint32_t len = 0;
+
+	while (str[len])
+		len++;
+
+	return (len + 1 + 3) & ~3;
+}
+
+static bool str_eq(const char *a, const char *b)
+{
+	while (*a && *a == *b) {
+		a++;
+		b++;
+	}
+
+	return *a == *b;
+}
+
+/*
+ * Does @name, a node name, match the first component of @path? Return the
+ * rest of the path if so.
+ */
+static const char *match_component(const char *path, const char *name)
+{
+	while (*path && *path != '/' && *path == *name) {
+		path++;
+		name++;
+	}
+
+	if (*name || (*path && *path != '/'))
+		return NULL;
+
+	while (*path == '/')
+		path++;
+
+	return path;
+}
+
+#define FDT_MAX_DEPTH		16
+
+/**
+ * Find property @name of the node at absolute @path
+ *
+ * Return a pointer to the value, and its length in @len, or NULL if the node
+ * or property doesn't exist.
+ */
+void *fdt_find_prop(void *fdt, const char *path, const char *name,
+		    uint32_t *len)
+{
+	struct fdt_header *hdr = fdt;
+	uint32_t *token;
+	const char *strings;
+	/* Path left to match below the first d open nodes */
+	const char *remaining[FDT_MAX_DEPTH + 1];
+	/* Number of open nodes, and how many of them are on the path */
+	int depth = 0, matched = 0;
+
+	if (fdt32(hdr->magic) != FDT_MAGIC)
+		return NULL;
+
+	token = fdt + fdt32(hdr->off_dt_struct);
+	strings = fdt + fdt32(hdr->off_dt_strings);
+
+	while (*path == '/')
+		path++;
+
+	for (;;) {
+		uint32_t tag = fdt32(*token++);
+		const char *node, *rest;
+		uint32_t plen, nameoff;
+
+		switch (tag) {
+		case FDT_BEGIN_NODE:
+			node = (const char *)token;
+			token += token_len(node) / 4;
+
+			if (depth == FDT_MAX_DEPTH)
+				return NULL;
+
+			if (depth == 0) {
+				remaining[1] = path;
+				matched = 1;
+			} else if (matched == depth && *remaining[depth]) {
+				rest = match_component(remaining[depth], node);
+				if (rest) {
+					remaining[depth + 1] = rest;
+					matched++;
+				}
+			}
+
+			depth++;
+			break;
+		case FDT_END_NODE:
+			if (matched == depth)
+				matched--;
+			depth--;
+			break;
+		case FDT_PROP:
+			plen = fdt32(token[0]);
+			nameoff = fdt32(token[1]);
+
+			if (depth && matched == depth && !*remaining[depth] &&
+			    str_eq(strings + nameoff, name)) {
+				*len = plen;
+				return token + 2;
+			}
+
+			token += 2 + (plen + 3) / 4;
+			break;
+		case FDT_NOP:
+			break;
+		case FDT_END:
+		default:
+			return NULL;
+		}
+	}
+}
+
+/*
+ * Fill a placeholder with big-endian 64-bit values, zeroing whatever is left
+ * of it.
+ */
+int fdt_set_prop_u64s(void *fdt, const char *path, const char *name,
+		      const uint64_t *vals, unsigned int count)
+{
+	uint32_t len, i;
+	uint32_t *prop = fdt_find_prop(fdt, path, name, &len);
+
+	if (!prop || len % sizeof(uint64_t) || len < count * sizeof(uint64_t))
+		return -1;
+
+	for (i = 0; i < len / sizeof(uint32_t); i++) {
+		uint64_t val = i / 2 < count ? vals[i / 2] : 0;
+
+		prop[i] = fdt32(i % 2 ? (uint32_t)val : (uint32_t)(val >> 32));
+	}
+
+	return 0;
+}
+
+/*
+ * Add @offset to the first value of a property, an address of @cells cells
+ * (1 or 2), leaving the rest of the property alone.
+ */
+int fdt_offset_prop(void *fdt, const char *path, const char *name,
+		    unsigned int cells, uint64_t offset)
+{
+	uint32_t len;
+	uint32_t *prop = fdt_find_prop(fdt, path, name, &len);
+	uint64_t val;
+
+	if (!prop || (cells != 1 && cells != 2) ||
+	    len < cells * sizeof(uint32_t))
+		return -1;
+
+	if (cells == 1) {
+		*prop = fdt32(fdt32(*prop) + (uint32_t)offset);
+		return 0;
+	}
+
+	val = ((uint64_t)fdt32(prop[0]) << 32 | fdt32(prop[1])) + offset;
+	prop[0] = fdt32((uint32_t)(val >> 32));
+	prop[1] = fdt32((uint32_t)val);
+	return 0;
+}
@@ -6,9 +6,18 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE.txt file.
  */
+#include <stdbool.h>
+
 #include <boot.h>
 #include <cpu.h>
+#include <loader.h>
 #include <platform.h>
+#include <reloc.h>
+#include <rng.h>
+#include <scrub.h>
+#include <smc_stats.h>
+#include <snapshot.h>
+#include <xip.h>
 
 static void announce_bootwrapper(void)
 {
@@ -31,6 +40,10 @@ static void announce_objects(void)
 	print_string("Memory layout:\r\n");
 	announce_object(text, "boot-wrapper");
 	announce_object(mbox, "mbox");
+#ifdef BOOTLOG
+	announce_object(bootlog, "boot log");
+#endif
+#ifndef SEMIHOSTING_LOADER
 	announce_object(kernel, "kernel");
 #ifdef XEN
 	announce_object(xen, "xen");
@@ -39,21 +52,51 @@ static void announce_objects(void)
 #ifdef USE_INITRD
 	announce_object(filesystem, "initrd");
 #endif
+#endif
+#ifdef SYSTEM_RESET
+	announce_object(snapshot, "snapshot");
+#endif
+#ifdef SMC_STATS
+	announce_object(smc_stats, "SMC statistics");
+#endif
+	announce_object(bss, "bss");
+	announce_object(stack, "stacks");
 }
 
 void announce_arch(void);
 
 static void init_bootwrapper(void)
 {
-	init_uart();
+#ifdef SYSTEM_RESET
+	/* Before anything modifies .data */
+	snapshot_take();
+#endif
+	init_console();
+#ifdef SMC_STATS
+	smc_stats_init();
+#endif
 	announce_bootwrapper();
 	announce_arch();
 	announce_objects();
+#ifdef PIE
+	relocate_dt();
+#endif
+#ifdef SEMIHOSTING_LOADER
+	loader_load();
+#endif
 	init_platform();
 }
 
 static void cpu_init_self(unsigned int cpu)
 {
+#ifdef EARLY_HANDOFF
+	/* The kernel may own the console by now */
+	if (cpu != 0) {
+		cpu_init_arch(cpu);
+		return;
+	}
+#endif
+
 	print_string("CPU");
 	print_uint_dec(cpu);
 	print_string(": (MPIDR ");
@@ -63,13 +106,53 @@ static void cpu_init_self(unsigned int cpu)
 	cpu_init_arch(cpu);
 }
 
+/* In .data: .bss isn't loaded, and holds garbage until the primary zeroes it */
+static volatile bool bss_dirty = true;
+
+static void clear_bss(void)
+{
+	extern char bss__start[], bss__end[];
+	volatile unsigned long *p;
+
+	/* Word stores: with the MMU off, accesses must be aligned */
+	for (p = (void *)bss__start; p < (unsigned long *)bss__end; p++)
+		*p = 0;
+}
+
 void cpu_init_bootwrapper(void)
 {
 	static volatile unsigned int cpu_next = 0;
 	unsigned int cpu = this_cpu_logical_id();
 
-	if (cpu == 0)
+	if (cpu == 0 && bss_dirty) {
+		clear_bss();
 		init_bootwrapper();
+		dsb(sy);
+		bss_dirty = false;
+		dsb(sy);
+		sev();
+	}
+
+	while (bss_dirty)
+		wfe();
+
+#ifdef FVP_PWRC_BASE
+	/* Powered back up by PSCI: only this CPU needs setting up again */
+	if (cpu_next > cpu) {
+		cpu_init_arch(cpu);
+		return;
+	}
+#endif
+
+#ifdef XIP
+	xip_copy_payloads(cpu);
+#endif
+
+#ifdef RNG_SEED
+	/* Once the DT is in place, and afresh after each SYSTEM_RESET */
+	if (cpu == 0)
+		rng_seed_dt();
+#endif
 
 	while (cpu_next != cpu)
 		wfe();
@@ -80,11 +163,26 @@ void cpu_init_bootwrapper(void)
 	dsb(sy);
 	sev();
 
+#ifdef SCRUB
+	while (cpu_next != NR_CPUS)
+		wfe();
+
+	scrub_memory(cpu);
+#endif
+
 	if (cpu != 0)
 		return;
 
+#ifdef EARLY_HANDOFF
+	/*
+	 * Secondaries finish in the background. Until they do, PSCI reports
+	 * them as pending after CPU_ON, and spin-table leaves the mbox alone.
+	 */
+	print_string("Entering kernel, other CPUs initializing...\r\n\r\n");
+#else
 	while (cpu_next != NR_CPUS)
 		wfe();
 
 	print_string("All CPUs initialized. Entering kernel...\r\n\r\n");
+#endif
 }
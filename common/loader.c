@@ -0,0 +1,176 @@
+/*
+ * loader.c - load the payloads over semihosting
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Instead of being linked into the image, the kernel, DTB and initrd are read
+ * from the host when the primary CPU boots, at the addresses the static layout
+ * would have used. The kernel's load offset is found from its Image header, as
+ * scripts/layout.pl does at build time otherwise.
+ */
+#include <stdint.h>
+
+#include <boot.h>
+#include <cpu.h>
+#include <fdt.h>
+#include <loader.h>
+#include <platform.h>
+#include <semihosting.h>
+
+#define AA64_IMAGE_MAGIC	0x644d5241
+#define SZ_2M			0x200000
+
+struct aa64_image_header {
+	uint32_t code0;
+	uint32_t code1;
+	uint64_t text_offset;
+	uint64_t image_size;
+	uint64_t flags;
+	uint64_t res2;
+	uint64_t res3;
+	uint64_t res4;
+	uint32_t magic;
+	uint32_t res5;
+};
+
+unsigned long loader_entrypoint;
+
+static void __noreturn loader_fail(const char *path, const char *msg)
+{
+	print_string("Loader: ");
+	print_string(path);
+	print_string(": ");
+	print_string(msg);
+	print_string("\r\n");
+
+	while (1)
+		wfi();
+}
+
+static long open_file(const char *path, unsigned long *size)
+{
+	long fd = semihosting_open(path);
+	long len;
+
+	if (fd == -1)
+		loader_fail(path, "cannot open file");
+
+	len = semihosting_flen(fd);
+	if (len < 0)
+		loader_fail(path, "cannot get file size");
+
+	*size = len;
+	return fd;
+}
+
+/*
+ * Read a whole file at PHYS_OFFSET + @offset. @limit is the offset of the next
+ * object in the layout, if any.
+ */
+static void load_file(long fd, const char *path, unsigned long offset,
+		      unsigned long size, unsigned long limit,
+		      const char *desc)
+{
+	unsigned long start = PHYS_OFFSET + offset;
+
+	if (limit && offset + size > limit)
+		loader_fail(path, "too large for the layout");
+
+	if (semihosting_seek(fd, 0) || semihosting_read(fd, (void *)start, size))
+		loader_fail(path, "read failed");
+
+	semihosting_close(fd);
+
+	print_string("[");
+	print_ulong_hex(start);
+	print_string("..");
+	print_ulong_hex(start + size);
+	print_string("] => ");
+	print_string(desc);
+	print_string(" (loaded)\r\n");
+}
+
+#ifndef KERNEL_32
+/* See AA64Image.pm */
+static unsigned long aa64_load_offset(long fd, const char *path,
+				      unsigned long *image_size)
+{
+	struct aa64_image_header hdr;
+	unsigned long text_offset, min = TEXT_LIMIT;
+
+	if (semihosting_read(fd, &hdr, sizeof(hdr)) ||
+	    hdr.magic != AA64_IMAGE_MAGIC)
+		loader_fail(path, "not an AArch64 Image");
+
+	*image_size = hdr.image_size;
+	text_offset = hdr.image_size ? hdr.text_offset : 0x80000;
+
+	if (min <= text_offset)
+		return text_offset;
+
+	/* text_offset bytes from a 2MB aligned base address */
+	return ((min + SZ_2M - 1) & ~(SZ_2M - 1)) + text_offset;
+}
+#endif
+
+static void load_kernel(void)
+{
+	const char *path = LOADER_KERNEL;
+	unsigned long offset, size, image_size;
+	long fd = open_file(path, &size);
+
+#ifdef KERNEL_32
+	offset = KERNEL_OFFSET;
+	image_size = size;
+#else
+	offset = aa64_load_offset(fd, path, &image_size);
+	if (image_size < size)
+		image_size = size;
+#endif
+
+	/* The kernel's .bss must not run into what follows it either */
+	if (offset + image_size > KERNEL_LIMIT)
+		loader_fail(path, "too large for the layout");
+
+	load_file(fd, path, offset, size, KERNEL_LIMIT, "kernel");
+	loader_entrypoint = PHYS_OFFSET + offset;
+}
+
+static void load_dtb(void)
+{
+	const char *path = LOADER_DTB;
+	unsigned long size;
+	long fd = open_file(path, &size);
+
+	load_file(fd, path, FDT_OFFSET, size, FDT_LIMIT, "dtb");
+}
+
+#ifdef USE_INITRD
+static void load_initrd(void)
+{
+	const char *path = LOADER_INITRD;
+	unsigned long start = PHYS_OFFSET + FS_OFFSET;
+	unsigned long size;
+	long fd = open_file(path, &size);
+	uint64_t end = start + size;
+
+	load_file(fd, path, FS_OFFSET, size, FS_LIMIT, "initrd");
+
+	/* The DT was generated with the size of the initrd at build time */
+	if (fdt_set_prop_u64s(&dtb, "/chosen", "linux,initrd-end", &end, 1))
+		loader_fail(LOADER_DTB, "no linux,initrd-end to update");
+}
+#endif
+
+void loader_load(void)
+{
+	load_kernel();
+	load_dtb();
+#ifdef USE_INITRD
+	load_initrd();
+#endif
+}
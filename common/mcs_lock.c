@@ -0,0 +1,79 @@
+/*
+ * mcs_lock.c - Mellor-Crummey and Scott queue lock
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Queue lock as described in [1]. Each waiting CPU spins on its own node, and
+ * acquiring or releasing the lock costs a constant number of accesses,
+ * regardless of NR_CPUS.
+ *
+ * Unlike the bakery lock, this algorithm relies on exclusive accesses to
+ * update the tail of the queue. It must only be used when the lock lives in
+ * Normal, cacheable, shareable memory, since exclusives are not guaranteed to
+ * work on Device memory.
+ *
+ * [1] Mellor-Crummey, J. M. and Scott, M. L. "Algorithms for Scalable
+ *     Synchronization on Shared-Memory Multiprocessors"
+ */
+
+#include <cpu.h>
+#include <mcs_lock.h>
+
+#include <asm/atomic.h>
+
+#define MCS_NONE		0
+#define mcs_id(cpu)		((cpu) + 1)
+#define mcs_node(lock, id)	(&(lock)->nodes[(id) - 1])
+
+void mcs_lock(mcs_lock_t *lock, unsigned self)
+{
+	struct mcs_node *node = &lock->nodes[self];
+	unsigned long prev;
+
+	node->next = MCS_NONE;
+	node->locked = 1;
+
+	/* Publish our node, acquire-release orders the writes above */
+	prev = atomic_xchg(&lock->tail, mcs_id(self));
+	if (prev == MCS_NONE)
+		return;
+
+	mcs_node(lock, prev)->next = mcs_id(self);
+
+	dsb(st);
+	sev();
+
+	while (node->locked)
+		wfe();
+
+	dmb(sy);
+}
+
+void mcs_unlock(mcs_lock_t *lock, unsigned self)
+{
+	struct mcs_node *node = &lock->nodes[self];
+	unsigned long next;
+
+	dmb(sy);
+
+	next = node->next;
+	if (next == MCS_NONE) {
+		/* Nobody queued behind us: try to leave the queue empty */
+		if (atomic_cmpxchg(&lock->tail, mcs_id(self), MCS_NONE) ==
+		    mcs_id(self))
+			return;
+
+		/* A successor swapped the tail, wait until it links itself */
+		while ((next = node->next) == MCS_NONE)
+			wfe();
+	}
+
+	mcs_node(lock, next)->locked = 0;
+
+	dsb(st);
+	sev();
+}
@@ -0,0 +1,84 @@
+/*
+ * partition.c - independent kernels on disjoint sets of CPUs
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Partition 0 is the main kernel. The others, laid out by
+ * scripts/partitions.pl, each own the CPUs and memory of their DT. The lowest
+ * CPU of a partition boots its kernel, and PSCI keeps each kernel to its own
+ * CPUs. The GIC distributor isn't split: only partition 0 can use SPIs, see
+ * scripts/partitions.pl.
+ */
+#include <boot.h>
+#include <cpu.h>
+#include <lock.h>
+#include <partition.h>
+
+static const unsigned int cpu_partition[NR_CPUS] = { PARTITION_CPUS };
+
+/* Partition 0's are only known at link time, see kernel_entrypoint() */
+static const unsigned long partition_entries[NR_PARTITIONS] = {
+	0, PARTITION_ENTRIES
+};
+static const unsigned long partition_dtbs[NR_PARTITIONS] = {
+	0, PARTITION_DTBS
+};
+
+static lock_t partition_lock;
+static bool partition_off[NR_PARTITIONS];
+static unsigned int nr_partitions_off;
+
+bool partition_is_boot_cpu(unsigned int cpu)
+{
+	unsigned int other;
+
+	for (other = 0; other < cpu; other++)
+		if (same_partition(cpu, other))
+			return false;
+
+	return true;
+}
+
+bool same_partition(unsigned int cpu, unsigned int other)
+{
+	return cpu_partition[cpu] == cpu_partition[other];
+}
+
+unsigned long partition_entrypoint(unsigned int cpu)
+{
+	unsigned int partition = cpu_partition[cpu];
+
+	return partition ? partition_entries[partition] : kernel_entrypoint();
+}
+
+unsigned long partition_dtb(unsigned int cpu)
+{
+	unsigned int partition = cpu_partition[cpu];
+
+	return partition ? partition_dtbs[partition] : (unsigned long)&dtb;
+}
+
+/*
+ * Record that the partition of @cpu asked for SYSTEM_OFF, and return true
+ * once all of them have.
+ */
+bool partition_system_off(unsigned int cpu)
+{
+	unsigned int partition = cpu_partition[cpu];
+	bool last;
+
+	lock_acquire(&partition_lock, cpu);
+	if (!partition_off[partition]) {
+		partition_off[partition] = true;
+		nr_partitions_off++;
+	}
+	last = nr_partitions_off == NR_PARTITIONS;
+	lock_release(&partition_lock, cpu);
+
+	/* Silently: the other partitions' kernels own the console by now */
+	return last;
+}
@@ -8,10 +8,18 @@
  */
 
 #include <cpu.h>
+#include <platform.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include <asm/dcc.h>
 #include <asm/io.h>
 
+#include <bootlog.h>
+#include <lock.h>
+#include <semihosting.h>
+
 #define PL011_UARTDR		0x00
 #define PL011_UARTFR		0x18
 #define PL011_UARTIBRD		0x24
@@ -29,9 +37,52 @@
 #define V2M_SYS_CFGCTRL		0xa4
 
 #define V2M_SYS(reg)	((void *)SYSREGS_BASE + V2M_SYS_##reg)
+
+#define V2M_SYS_CFG_SHUTDOWN	8
+#define V2M_SYS_CFG_REBOOT	9
+#elif defined(SYSTEM_OFF_SYSREG)
+#error "SYSTEM_OFF through the system registers needs SYSREGS_BASE"
 #endif
 
-void print_char(char c)
+#ifdef FVP_PWRC_BASE
+#define FVP_PWRC_PPOFFR		0x00
+#define FVP_PWRC_PPONR		0x04
+#define FVP_PWRC_PWKUPR		0x0c
+#define FVP_PWRC_PSYSR		0x10
+
+#define FVP_PWRC_PSYSR_AFF_L0	(1U << 29)
+#define FVP_PWRC_PSYSR_WK(psysr)	(((psysr) >> 24) & 0x3)
+#define FVP_PWRC_PSYSR_WK_PPONR	2
+
+#define FVP_PWRC(reg)	((void *)FVP_PWRC_BASE + FVP_PWRC_##reg)
+#endif
+
+/*
+ * The console backend, chosen at configure time. Backends that can write a
+ * string get whole lines, see console_putc().
+ */
+struct console_ops {
+	void (*init)(void);
+	void (*putc)(char c);
+	/* Optional, writes a NUL-terminated string */
+	void (*puts)(const char *str);
+};
+
+#if defined(CONSOLE_PL011)
+static void pl011_init(void)
+{
+	/*
+	 * UART initialisation (38400 8N1)
+	 */
+	raw_writel(0x10,	PL011(UARTIBRD));
+	raw_writel(0x0,		PL011(UARTFBRD));
+	/* Set parameters to 8N1 and enable the FIFOs */
+	raw_writel(0x70,	PL011(UART_LCR_H));
+	/* Enable the UART, TXen and RXen */
+	raw_writel(0x301,	PL011(UARTCR));
+}
+
+static void pl011_putc(char c)
 {
 	uint32_t flags;
 
@@ -46,10 +97,86 @@ void print_char(char c)
 	} while (flags & PL011_UARTFR_BUSY);
 }
 
+static const struct console_ops console = {
+	.init	= pl011_init,
+	.putc	= pl011_putc,
+};
+#elif defined(CONSOLE_SEMIHOSTING)
+/* One trap per line rather than per character */
+static const struct console_ops console = {
+	.putc	= semihosting_writec,
+	.puts	= semihosting_write0,
+};
+#elif defined(CONSOLE_DCC)
+static const struct console_ops console = {
+	.putc	= dcc_putc,
+};
+#else
+/* Output only goes to the boot log, if any */
+static const struct console_ops console;
+#endif
+
+#define CONSOLE_LINE_SIZE	128
+
+/* Per CPU, so that lines printed concurrently don't mix */
+struct console_line {
+	unsigned int len;
+	char buf[CONSOLE_LINE_SIZE];
+};
+
+static struct console_line console_lines[NR_CPUS];
+
+/* NULL if lines aren't buffered, or this CPU has none */
+static struct console_line *console_this_line(void)
+{
+	unsigned int cpu;
+
+	if (!console.puts)
+		return NULL;
+
+	cpu = this_cpu_logical_id();
+	if (cpu >= NR_CPUS)
+		return NULL;
+
+	return &console_lines[cpu];
+}
+
+static void console_putc(struct console_line *line, char c)
+{
+	if (!line) {
+		if (console.putc)
+			console.putc(c);
+		return;
+	}
+
+	line->buf[line->len++] = c;
+
+	if (c == '\n' || line->len == CONSOLE_LINE_SIZE - 1) {
+		line->buf[line->len] = '\0';
+		console.puts(line->buf);
+		line->len = 0;
+	}
+}
+
+void print_char(char c)
+{
+#ifdef BOOTLOG
+	bootlog_putc(c);
+#endif
+	console_putc(console_this_line(), c);
+}
+
+/* The CPU's line is only looked up once per string */
 void print_string(const char *str)
 {
-	while (*str)
-		print_char(*str++);
+	struct console_line *line = console_this_line();
+
+	for (; *str; str++) {
+#ifdef BOOTLOG
+		bootlog_putc(*str);
+#endif
+		console_putc(line, *str);
+	}
 }
 
 #define HEX_CHARS_PER_LONG	(2 * sizeof(long))
@@ -57,31 +184,38 @@ void print_string(const char *str)
 
 void print_ulong_hex(unsigned long val)
 {
+	char str[HEX_CHARS_PER_LONG + 1];
 	int i;
 
 	for (i = HEX_CHARS_PER_LONG - 1; i >= 0; i--) {
 		int v = (val >> (4 * i)) & 0xf;
-		print_char(HEX_CHARS[v]);
+		str[HEX_CHARS_PER_LONG - 1 - i] = HEX_CHARS[v];
 	}
+	str[HEX_CHARS_PER_LONG] = '\0';
+
+	print_string(str);
 }
 
-// 2^32 is 4,294,967,296
-#define DEC_CHARS_PER_UINT	10
+// 2^64 is 18,446,744,073,709,551,616
+#define DEC_CHARS_PER_ULONG	20
 
-void print_uint_dec(unsigned int val)
+void print_ulong_dec(unsigned long val)
 {
-	char digits[DEC_CHARS_PER_UINT];
-	int d = 0;
+	char str[DEC_CHARS_PER_ULONG + 1];
+	int d = DEC_CHARS_PER_ULONG;
 
+	str[d] = '\0';
 	do {
-		digits[d] = val % 10;
+		str[--d] = '0' + val % 10;
 		val /= 10;
-		d++;
 	} while (val);
 
-	while (d--) {
-		print_char('0' + digits[d]);
-	}
+	print_string(&str[d]);
+}
+
+void print_uint_dec(unsigned int val)
+{
+	print_ulong_dec(val);
 }
 
 void print_cpu_warn(unsigned int cpu, const char *str)
@@ -100,17 +234,14 @@ void print_cpu_msg(unsigned int cpu, const char *str)
 	print_string(str);
 }
 
-void init_uart(void)
+void init_console(void)
 {
-	/*
-	 * UART initialisation (38400 8N1)
-	 */
-	raw_writel(0x10,	PL011(UARTIBRD));
-	raw_writel(0x0,		PL011(UARTFBRD));
-	/* Set parameters to 8N1 and enable the FIFOs */
-	raw_writel(0x70,	PL011(UART_LCR_H));
-	/* Enable the UART, TXen and RXen */
-	raw_writel(0x301,	PL011(UARTCR));
+#ifdef BOOTLOG
+	bootlog_init();
+#endif
+
+	if (console.init)
+		console.init();
 }
 
 void init_platform(void)
@@ -125,3 +256,124 @@ void init_platform(void)
 				V2M_SYS(CFGCTRL));
 #endif
 }
+
+#ifdef SYSREGS_BASE
+static void v2m_sys_cfg_write(unsigned int function)
+{
+	raw_writel(0x0,		V2M_SYS(CFGDATA));
+	/* START | WRITE | function | SITE_MB */
+	raw_writel((1 << 31) | (1 << 30) | (function << 20) | (0 << 16),
+				V2M_SYS(CFGCTRL));
+}
+
+void __noreturn platform_system_reset(void)
+{
+	v2m_sys_cfg_write(V2M_SYS_CFG_REBOOT);
+
+	while (1)
+		wfi();
+}
+#endif
+
+#ifdef FVP_PWRC_BASE
+/* PSYSR is written with an MPIDR, then read: one CPU at a time */
+static lock_t pwrc_lock;
+
+#ifdef XIP
+/* Set while platform_cpu_on() waits for its target to read PSYSR */
+static volatile bool pwrc_waking;
+#endif
+
+static uint32_t fvp_pwrc_psysr(unsigned long mpidr)
+{
+	raw_writel(mpidr, FVP_PWRC(PSYSR));
+	return raw_readl(FVP_PWRC(PSYSR));
+}
+
+static bool fvp_pwrc_cpu_is_on(unsigned int self, unsigned long mpidr)
+{
+	uint32_t psysr;
+
+	lock_acquire(&pwrc_lock, self);
+	psysr = fvp_pwrc_psysr(mpidr);
+	lock_release(&pwrc_lock, self);
+
+	return psysr & FVP_PWRC_PSYSR_AFF_L0;
+}
+
+#ifdef XIP
+/**
+ * Whether this CPU was powered back up by platform_cpu_on(), rather than
+ * reset. It is called before .data is in place, so can't take pwrc_lock: the
+ * CPU that powered it up holds the lock until then. On a cold boot, every CPU
+ * reads as reset whichever MPIDR another one selected meanwhile.
+ */
+bool platform_cpu_woken(void)
+{
+	uint32_t psysr = fvp_pwrc_psysr(read_mpidr());
+
+	if (FVP_PWRC_PSYSR_WK(psysr) != FVP_PWRC_PSYSR_WK_PPONR)
+		return false;
+
+	pwrc_waking = false;
+	dsb(sy);
+	sev();
+
+	return true;
+}
+#endif
+
+/**
+ * Power this CPU down, with interrupts unable to wake it. It comes back
+ * through the reset vector once platform_cpu_on() is called for it.
+ */
+void __noreturn platform_cpu_off(unsigned long mpidr)
+{
+	raw_writel(mpidr, FVP_PWRC(PWKUPR));
+	raw_writel(mpidr, FVP_PWRC(PPOFFR));
+	dsb(sy);
+
+	while (1)
+		wfi();
+}
+
+/**
+ * Power a CPU up once it is fully down: a CPU that was just told to power off
+ * only goes down when it reaches WFI.
+ */
+void platform_cpu_on(unsigned int self, unsigned long mpidr)
+{
+	while (fvp_pwrc_cpu_is_on(self, mpidr))
+		;
+
+#ifdef XIP
+	/* See platform_cpu_woken() */
+	lock_acquire(&pwrc_lock, self);
+	pwrc_waking = true;
+	dsb(sy);
+	raw_writel(mpidr, FVP_PWRC(PPONR));
+
+	while (pwrc_waking)
+		wfe();
+	lock_release(&pwrc_lock, self);
+#else
+	raw_writel(mpidr, FVP_PWRC(PPONR));
+#endif
+}
+#endif
+
+/**
+ * Called by the last CPU running once all others are parked. Falls back to
+ * parking this CPU as well.
+ */
+void __noreturn platform_system_off(void)
+{
+#if defined(SYSTEM_OFF_SEMIHOSTING)
+	semihosting_exit(0);
+#elif defined(SYSTEM_OFF_SYSREG)
+	v2m_sys_cfg_write(V2M_SYS_CFG_SHUTDOWN);
+#endif
+
+	while (1)
+		wfi();
+}
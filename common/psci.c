@@ -7,45 +7,351 @@
  * found in the LICENSE.txt file.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 
-#include <bakery_lock.h>
 #include <boot.h>
 #include <cpu.h>
+#include <lock.h>
+#include <partition.h>
 #include <platform.h>
 #include <psci.h>
+#include <rng.h>
+#include <smc_stats.h>
+#include <snapshot.h>
+
+#ifdef LOCK_HAS_EXCLUSIVES
+#include <asm/atomic.h>
+#endif
 
 #ifndef CPU_IDS
 #error "No MPIDRs provided"
 #endif
 
-static unsigned long branch_table[NR_CPUS];
+#if defined(SYSTEM_RESET) && !defined(SYSREGS_BASE)
+#error "SYSTEM_RESET needs the V2M system registers"
+#endif
+
+#if COUNTER_FREQ <= 1000000
+#error "PSCI statistics need a counter faster than 1MHz"
+#endif
+
+/*
+ * Entry point of each CPU, PSCI_ADDR_INVALID while it is off. Callers of
+ * CPU_ON only ever move a slot away from PSCI_ADDR_INVALID, and only the CPU
+ * owning the slot moves it back, in CPU_OFF.
+ */
+static unsigned long branch_table[NR_CPUS] = {
+	[0 ... NR_CPUS - 1] = PSCI_ADDR_INVALID,
+};
 
-bakery_ticket_t branch_table_lock[NR_CPUS];
+/* Set by a CPU once it has picked up the address in its slot */
+static volatile bool cpu_is_on[NR_CPUS];
+
+/*
+ * Power states tracked for PSCI_STAT_RESIDENCY and PSCI_STAT_COUNT: CPU_OFF,
+ * and the standby state of CPU_SUSPEND.
+ */
+enum psci_state {
+	PSCI_STATE_CPU_OFF,
+	PSCI_STATE_STANDBY,
+	PSCI_NR_STATES,
+};
+
+static const unsigned long psci_state_param[PSCI_NR_STATES] = {
+	[PSCI_STATE_CPU_OFF]	= PSCI_POWER_STATE_CPU_OFF,
+	[PSCI_STATE_STANDBY]	= PSCI_POWER_STATE_STANDBY,
+};
+
+/*
+ * Entries into a state and time spent there, in CNTPCT ticks. Only the CPU
+ * itself updates its statistics. entered is non-zero while it is in the state.
+ * seq is odd while an update is in progress, see psci_stat_residency().
+ */
+struct psci_stat {
+	unsigned long seq;
+	uint64_t count;
+	uint64_t residency;
+	uint64_t entered;
+};
 
-static int psci_store_address(unsigned int cpu, unsigned long address)
+static volatile struct psci_stat psci_stats[NR_CPUS][PSCI_NR_STATES];
+
+#ifdef FVP_PWRC_BASE
+/*
+ * Set by a CPU before it asks the power controller to turn it off, so that it
+ * can tell a warm boot from a cold one when it is turned back on.
+ */
+static volatile bool cpu_powered_off[NR_CPUS];
+#endif
+
+#ifdef LOCK_HAS_EXCLUSIVES
+
+static bool psci_claim_slot(unsigned int cpu, unsigned long address)
 {
-	if (branch_table[cpu] != PSCI_ADDR_INVALID)
-		return PSCI_RET_ALREADY_ON;
+	return atomic_cmpxchg(&branch_table[cpu], PSCI_ADDR_INVALID,
+			      address) == PSCI_ADDR_INVALID;
+}
 
-	branch_table[cpu] = address;
-	return PSCI_RET_SUCCESS;
+#else
+
+/*
+ * Without exclusives, each slot is guarded by Lamport's fast mutual exclusion
+ * algorithm [1]. It takes a constant number of accesses when the slot isn't
+ * contended, and each slot has its own state, so CPU_ON calls aimed at
+ * different CPUs never wait for each other. Like the bakery lock, it relies on
+ * Device accesses being performed in program order, which is why Armv8-R, with
+ * the boot-wrapper data in Normal memory, always builds with the MCS lock.
+ *
+ * slot_x and slot_y hold (logical ID + 1) of a caller, zero meaning none.
+ * claiming[caller] holds (slot + 1) while a caller is in that slot's doorway.
+ * A caller claims one slot at a time, so this takes O(NR_CPUS) space.
+ *
+ * [1] Lamport, L. "A Fast Mutual Exclusion Algorithm"
+ */
+static volatile unsigned long slot_x[NR_CPUS];
+static volatile unsigned long slot_y[NR_CPUS];
+static volatile unsigned long claiming[NR_CPUS];
+
+static void slot_lock(unsigned int cpu, unsigned int self)
+{
+	unsigned long id = self + 1;
+	unsigned long slot = cpu + 1;
+	unsigned int other;
+
+	for (;;) {
+		claiming[self] = slot;
+		slot_x[cpu] = id;
+		if (slot_y[cpu] != 0) {
+			claiming[self] = 0;
+			dsb(st);
+			sev();
+			while (slot_y[cpu] != 0)
+				wfe();
+			continue;
+		}
+
+		slot_y[cpu] = id;
+		if (slot_x[cpu] == id)
+			break;
+
+		/* Contended: wait for everyone who may have seen slot_y clear */
+		claiming[self] = 0;
+		dsb(st);
+		sev();
+		for (other = 0; other < NR_CPUS; other++)
+			while (claiming[other] == slot)
+				wfe();
+
+		if (slot_y[cpu] == id)
+			break;
+
+		while (slot_y[cpu] != 0)
+			wfe();
+	}
+
+	dmb(sy);
 }
 
-static int psci_cpu_on(unsigned long target_mpidr, unsigned long address)
+static void slot_unlock(unsigned int cpu, unsigned int self)
+{
+	dmb(sy);
+
+	slot_y[cpu] = 0;
+	claiming[self] = 0;
+
+	dsb(st);
+	sev();
+}
+
+static bool psci_claim_slot(unsigned int cpu, unsigned long address)
 {
-	int ret;
-	unsigned int cpu = find_logical_id(target_mpidr);
 	unsigned int this_cpu = this_cpu_logical_id();
+	bool claimed = false;
+
+	slot_lock(cpu, this_cpu);
+	if (branch_table[cpu] == PSCI_ADDR_INVALID) {
+		branch_table[cpu] = address;
+		claimed = true;
+	}
+	slot_unlock(cpu, this_cpu);
+
+	return claimed;
+}
+
+#endif
+
+/*
+ * Logical ID of a target CPU. With partitions, the caller's partition is all
+ * there is.
+ */
+static unsigned int psci_target_cpu(unsigned long mpidr)
+{
+	unsigned int cpu = find_logical_id(mpidr);
+
+#ifdef PARTITIONS
+	if (cpu != MPIDR_INVALID && !same_partition(this_cpu_logical_id(), cpu))
+		return MPIDR_INVALID;
+#endif
+
+	return cpu;
+}
+
+static int psci_cpu_on(unsigned long target_mpidr, unsigned long address)
+{
+	unsigned int cpu = psci_target_cpu(target_mpidr);
 
 	if (cpu == MPIDR_INVALID)
 		return PSCI_RET_INVALID_PARAMETERS;
 
-	bakery_lock(branch_table_lock, this_cpu);
-	ret = psci_store_address(cpu, address);
-	bakery_unlock(branch_table_lock, this_cpu);
+	if (psci_claim_slot(cpu, address)) {
+		dsb(st);
+#ifdef FVP_PWRC_BASE
+		platform_cpu_on(this_cpu_logical_id(), target_mpidr);
+#else
+		sev();
+#endif
+		return PSCI_RET_SUCCESS;
+	}
 
-	return ret;
+	return cpu_is_on[cpu] ? PSCI_RET_ALREADY_ON : PSCI_RET_ON_PENDING;
+}
+
+/*
+ * Claim the slot of every matching CPU in one pass, and wake them together.
+ * CPUs that are already on, or on their way, are left alone. Returns the
+ * number of CPUs turned on.
+ */
+static long psci_cpu_on_batch(unsigned long target_affinity,
+			      unsigned long address, unsigned long lowest_level)
+{
+	unsigned long mask;
+	unsigned int cpu;
+	bool matched = false;
+	long count = 0;
+
+	if (lowest_level > 3)
+		return PSCI_RET_INVALID_PARAMETERS;
+
+	/* Aff0 to Aff2 are contiguous, and Aff3 is above them all */
+	mask = MPIDR_ID_BITS & ~((1UL << (8 * lowest_level)) - 1);
+
+	for (cpu = 0; cpu < NR_CPUS; cpu++) {
+		if ((id_table[cpu] ^ target_affinity) & mask)
+			continue;
+#ifdef PARTITIONS
+		if (!same_partition(this_cpu_logical_id(), cpu))
+			continue;
+#endif
+
+		matched = true;
+		if (!psci_claim_slot(cpu, address))
+			continue;
+
+		count++;
+#ifdef FVP_PWRC_BASE
+		dsb(st);
+		platform_cpu_on(this_cpu_logical_id(), id_table[cpu]);
+#endif
+	}
+
+	if (!matched)
+		return PSCI_RET_INVALID_PARAMETERS;
+
+#ifndef FVP_PWRC_BASE
+	if (count) {
+		dsb(st);
+		sev();
+	}
+#endif
+
+	return count;
+}
+
+static void psci_stat_begin(volatile struct psci_stat *stat)
+{
+	stat->seq++;
+	dmb(sy);
+}
+
+static void psci_stat_end(volatile struct psci_stat *stat)
+{
+	dmb(sy);
+	stat->seq++;
+}
+
+static void psci_stat_enter(unsigned int cpu, enum psci_state state)
+{
+	volatile struct psci_stat *stat = &psci_stats[cpu][state];
+
+	psci_stat_begin(stat);
+	stat->count++;
+	stat->entered = read_counter();
+	psci_stat_end(stat);
+}
+
+static void psci_stat_exit(unsigned int cpu, enum psci_state state)
+{
+	volatile struct psci_stat *stat = &psci_stats[cpu][state];
+
+	psci_stat_begin(stat);
+	stat->residency += read_counter() - stat->entered;
+	stat->entered = 0;
+	psci_stat_end(stat);
+}
+
+/**
+ * Wait for an entry point to appear in our slot, and jump to it.
+ */
+static void __noreturn psci_enter(unsigned int cpu)
+{
+	unsigned long addr;
+
+	while ((addr = branch_table[cpu]) == PSCI_ADDR_INVALID)
+		wfe();
+
+	psci_stat_exit(cpu, PSCI_STATE_CPU_OFF);
+	cpu_is_on[cpu] = true;
+
+	jump_kernel(addr, 0, 0, 0, 0);
+
+	unreachable();
+}
+
+static void __noreturn psci_wait(unsigned int cpu)
+{
+	psci_stat_enter(cpu, PSCI_STATE_CPU_OFF);
+
+#ifdef FVP_PWRC_BASE
+	/* CPU_ON powers us back up, and psci_first_spin() resumes us */
+	cpu_powered_off[cpu] = true;
+	dsb(sy);
+	platform_cpu_off(read_mpidr());
+#endif
+
+	psci_enter(cpu);
+}
+
+/*
+ * Only standby is supported, which is enough for PSCI v0.2 and later: wait for
+ * an interrupt, then return. entry_point and context_id don't apply to it.
+ */
+static int psci_cpu_suspend(unsigned long power_state)
+{
+	unsigned int cpu = this_cpu_logical_id();
+
+	if (cpu == MPIDR_INVALID)
+		return PSCI_RET_DENIED;
+
+	if (power_state != PSCI_POWER_STATE_STANDBY)
+		return PSCI_RET_INVALID_PARAMETERS;
+
+	psci_stat_enter(cpu, PSCI_STATE_STANDBY);
+	dsb(sy);
+	wfi();
+	psci_stat_exit(cpu, PSCI_STATE_STANDBY);
+
+	return PSCI_RET_SUCCESS;
 }
 
 static int psci_cpu_off(void)
@@ -55,24 +361,266 @@ static int psci_cpu_off(void)
 	if (cpu == MPIDR_INVALID)
 		return PSCI_RET_DENIED;
 
+	/*
+	 * Free the slot before clearing cpu_is_on: a caller that still finds
+	 * it taken then reports ALREADY_ON, which is true until we're parked.
+	 */
 	branch_table[cpu] = PSCI_ADDR_INVALID;
+	dmb(sy);
+	cpu_is_on[cpu] = false;
 
-	spin(branch_table + cpu, PSCI_ADDR_INVALID);
+	psci_wait(cpu);
+}
 
-	unreachable();
+static int psci_affinity_info(unsigned long target_affinity,
+			      unsigned long lowest_level)
+{
+	unsigned int cpu = psci_target_cpu(target_affinity);
+
+	/* Only individual CPUs are tracked */
+	if (cpu == MPIDR_INVALID || lowest_level != 0)
+		return PSCI_RET_INVALID_PARAMETERS;
+
+	if (cpu_is_on[cpu])
+		return PSCI_AFFINITY_ON;
+
+	if (branch_table[cpu] != PSCI_ADDR_INVALID)
+		return PSCI_AFFINITY_ON_PENDING;
+
+	return PSCI_AFFINITY_OFF;
+}
+
+static volatile struct psci_stat *psci_stat_find(unsigned long target_cpu,
+						 unsigned long power_state)
+{
+	unsigned int cpu = psci_target_cpu(target_cpu);
+	unsigned int state;
+
+	if (cpu == MPIDR_INVALID)
+		return NULL;
+
+	for (state = 0; state < PSCI_NR_STATES; state++)
+		if (psci_state_param[state] == power_state)
+			return &psci_stats[cpu][state];
+
+	return NULL;
+}
+
+/* 1us in 2^-32 ticks, so that the conversion needs no 64-bit division */
+#define PSCI_TICKS_TO_US_MULT	((1000000ULL << 32) / COUNTER_FREQ)
+
+static uint64_t psci_ticks_to_us(uint64_t ticks)
+{
+	return (ticks >> 32) * PSCI_TICKS_TO_US_MULT +
+	       ((ticks & 0xffffffff) * PSCI_TICKS_TO_US_MULT >> 32);
+}
+
+/*
+ * Include the current stay of a CPU that is in the state. Invalid parameters
+ * read as a state that was never entered.
+ */
+static unsigned long psci_stat_residency(unsigned long target_cpu,
+					 unsigned long power_state)
+{
+	volatile struct psci_stat *stat = psci_stat_find(target_cpu, power_state);
+	uint64_t entered, ticks;
+	unsigned long seq;
+
+	if (!stat)
+		return 0;
+
+	/* Retry if the target was entering or leaving the state meanwhile */
+	do {
+		while ((seq = stat->seq) & 1)
+			;
+		dmb(sy);
+		entered = stat->entered;
+		ticks = stat->residency;
+		dmb(sy);
+	} while (seq != stat->seq);
+
+	if (entered)
+		ticks += read_counter() - entered;
+
+	return psci_ticks_to_us(ticks);
+}
+
+static unsigned long psci_stat_count(unsigned long target_cpu,
+				     unsigned long power_state)
+{
+	volatile struct psci_stat *stat = psci_stat_find(target_cpu, power_state);
+
+	return stat ? stat->count : 0;
+}
+
+static int psci_system_off(void)
+{
+#ifdef PARTITIONS
+	/* The other partitions carry on until they are done too */
+	if (!partition_system_off(this_cpu_logical_id()))
+		return psci_cpu_off();
+#endif
+
+	platform_system_off();
+}
+
+#ifdef SYSTEM_RESET
+/*
+ * Put the images back as they were loaded, and reset the platform. The CPUs
+ * then go through the boot-wrapper again, as on a cold boot.
+ */
+static int psci_system_reset(void)
+{
+	snapshot_restore();
+	platform_system_reset();
 }
 
-long psci_call(unsigned long fid, unsigned long arg1, unsigned long arg2)
+static int psci_system_reset2(unsigned long reset_type, unsigned long cookie)
+{
+	/* Vendor-specific resets aren't supported */
+	if (reset_type != PSCI_RESET2_WARM)
+		return PSCI_RET_INVALID_PARAMETERS;
+
+	return psci_system_reset();
+}
+#endif
+
+static int psci_features(unsigned long fid)
 {
 	switch (fid) {
+	case PSCI_VERSION:
+	case PSCI_CPU_OFF:
+#ifdef KERNEL_32
+	case PSCI_CPU_SUSPEND_32:
+	case PSCI_CPU_ON_32:
+	case PSCI_AFFINITY_INFO_32:
+#else
+	case PSCI_CPU_SUSPEND_64:
+	case PSCI_CPU_ON_64:
+	case PSCI_AFFINITY_INFO_64:
+#endif
+	case PSCI_MIGRATE_INFO_TYPE:
+	case PSCI_FEATURES:
+#ifdef KERNEL_32
+	case PSCI_STAT_RESIDENCY_32:
+	case PSCI_STAT_COUNT_32:
+#else
+	case PSCI_STAT_RESIDENCY_64:
+	case PSCI_STAT_COUNT_64:
+#endif
+	case PSCI_SYSTEM_OFF:
+#ifdef SYSTEM_RESET
+	case PSCI_SYSTEM_RESET:
+#ifdef KERNEL_32
+	case PSCI_SYSTEM_RESET2_32:
+#else
+	case PSCI_SYSTEM_RESET2_64:
+#endif
+#endif
+#ifdef TRNG
+	case SMCCC_VERSION:
+#endif
+		return PSCI_RET_SUCCESS;
+	default:
+		return PSCI_RET_NOT_SUPPORTED;
+	}
+}
+
+#ifdef TRNG
+/* None of the Arm architecture workarounds are implemented */
+static int smccc_arch_features(unsigned long fid)
+{
+	switch (fid) {
+	case SMCCC_VERSION:
+	case SMCCC_ARCH_FEATURES:
+		return PSCI_RET_SUCCESS;
+	default:
+		return PSCI_RET_NOT_SUPPORTED;
+	}
+}
+#endif
+
+/*
+ * @res receives x1 to x3 for the calls that return more than x0. It is only
+ * provided with TRNG, see arch/aarch64/psci.S.
+ */
+long psci_call(unsigned long fid, unsigned long arg1, unsigned long arg2,
+	       unsigned long arg3, unsigned long *res)
+{
+	switch (fid) {
+	case PSCI_VERSION:
+		return PSCI_VERSION_VALUE;
 	case PSCI_CPU_OFF:
 		return psci_cpu_off();
 #ifdef KERNEL_32
+	case PSCI_CPU_SUSPEND_32:
+		return psci_cpu_suspend(arg1);
 	case PSCI_CPU_ON_32:
 		return psci_cpu_on(arg1, arg2);
+	case PSCI_AFFINITY_INFO_32:
+		return psci_affinity_info(arg1, arg2);
 #else
+	case PSCI_CPU_SUSPEND_64:
+		return psci_cpu_suspend(arg1);
 	case PSCI_CPU_ON_64:
 		return psci_cpu_on(arg1, arg2);
+	case PSCI_AFFINITY_INFO_64:
+		return psci_affinity_info(arg1, arg2);
+#endif
+	case PSCI_MIGRATE_INFO_TYPE:
+		return PSCI_MIGRATE_INFO_NONE;
+	case PSCI_FEATURES:
+		return psci_features(arg1);
+#ifdef KERNEL_32
+	case PSCI_STAT_RESIDENCY_32:
+		return psci_stat_residency(arg1, arg2);
+	case PSCI_STAT_COUNT_32:
+		return psci_stat_count(arg1, arg2);
+#else
+	case PSCI_STAT_RESIDENCY_64:
+		return psci_stat_residency(arg1, arg2);
+	case PSCI_STAT_COUNT_64:
+		return psci_stat_count(arg1, arg2);
+#endif
+	case PSCI_SYSTEM_OFF:
+		return psci_system_off();
+#ifdef SYSTEM_RESET
+	case PSCI_SYSTEM_RESET:
+		return psci_system_reset();
+#ifdef KERNEL_32
+	case PSCI_SYSTEM_RESET2_32:
+		return psci_system_reset2(arg1, arg2);
+#else
+	case PSCI_SYSTEM_RESET2_64:
+		return psci_system_reset2(arg1, arg2);
+#endif
+#endif
+#ifdef SMC_STATS
+	case SIP_SMC_STATS:
+		return smc_stats_control(arg1);
+#endif
+#ifdef KERNEL_32
+	case SIP_CPU_ON_BATCH_32:
+		return psci_cpu_on_batch(arg1, arg2, arg3);
+#else
+	case SIP_CPU_ON_BATCH_64:
+		return psci_cpu_on_batch(arg1, arg2, arg3);
+#endif
+#ifdef TRNG
+	case SMCCC_VERSION:
+		return SMCCC_VERSION_VALUE;
+	case SMCCC_ARCH_FEATURES:
+		return smccc_arch_features(arg1);
+	case TRNG_VERSION:
+		return trng_version();
+	case TRNG_FEATURES:
+		return trng_features(arg1);
+	case TRNG_GET_UUID:
+		return trng_get_uuid(res);
+	case TRNG_RND_32:
+		return trng_rnd(arg1, 32, res);
+	case TRNG_RND_64:
+		return trng_rnd(arg1, 64, res);
 #endif
 	default:
 		return PSCI_RET_NOT_SUPPORTED;
@@ -83,7 +631,27 @@ void __noreturn psci_first_spin(void)
 {
 	unsigned int cpu = this_cpu_logical_id();
 
-	first_spin(cpu, branch_table + cpu, PSCI_ADDR_INVALID);
+#ifdef FVP_PWRC_BASE
+	if (cpu_powered_off[cpu]) {
+		cpu_powered_off[cpu] = false;
+		psci_enter(cpu);
+	}
+#endif
+
+	if (cpu == 0) {
+		/* Started by first_spin, keep CPU_ON away from our slot */
+		branch_table[cpu] = kernel_entrypoint();
+		cpu_is_on[cpu] = true;
+		first_spin(cpu, branch_table + cpu, PSCI_ADDR_INVALID);
+	}
 
-	unreachable();
+#ifdef PARTITIONS
+	if (partition_is_boot_cpu(cpu)) {
+		branch_table[cpu] = partition_entrypoint(cpu);
+		cpu_is_on[cpu] = true;
+		first_spin(cpu, branch_table + cpu, PSCI_ADDR_INVALID);
+	}
+#endif
+
+	psci_wait(cpu);
 }
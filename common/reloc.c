@@ -0,0 +1,121 @@
+/*
+ * reloc.c - DT fixups for a position-independent boot-wrapper
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * The image is linked at PHYS_OFFSET, and the DT generated with the layout
+ * found there. When the image is loaded elsewhere, relocate() in arch/ fixes
+ * up the boot-wrapper itself, and the DT nodes that describe the layout are
+ * moved here by the same offset. The nodes keep their build-time unit
+ * addresses, which is how they are found.
+ *
+ * The memory nodes and the DT's own /memreserve/ entries describe the
+ * platform, and are left alone.
+ */
+#include <stdint.h>
+
+#include <cpu.h>
+#include <fdt.h>
+#include <platform.h>
+#include <reloc.h>
+
+#define SZ_2M			0x200000UL
+
+extern char text__start[];
+extern unsigned long dtb;
+
+static unsigned long reloc_offset;
+
+static char *append(char *buf, const char *str)
+{
+	while (*str)
+		*buf++ = *str++;
+	*buf = '\0';
+
+	return buf;
+}
+
+/* Like the Makefile's printf '%x' */
+static char *append_hex(char *buf, unsigned long val)
+{
+	int shift = sizeof(val) * 8 - 4;
+
+	while (shift > 0 && !((val >> shift) & 0xf))
+		shift -= 4;
+
+	for (; shift >= 0; shift -= 4)
+		*buf++ = "0123456789abcdef"[(val >> shift) & 0xf];
+	*buf = '\0';
+
+	return buf;
+}
+
+static void relocate_fail(const char *msg)
+{
+	print_string("Relocation: ");
+	print_string(msg);
+	print_string("\r\n");
+
+	while (1)
+		wfi();
+}
+
+/* Move /reserved-memory/<name>@<build-time address> */
+static void relocate_reserved(const char *name, const char *start)
+{
+	char path[64], *p;
+
+	p = append(path, "/reserved-memory/");
+	p = append(p, name);
+	p = append(p, "@");
+	append_hex(p, (unsigned long)start - reloc_offset);
+
+	if (fdt_offset_prop(&dtb, path, "reg", 2, (uint64_t)(long)reloc_offset))
+		relocate_fail("reserved memory node missing from the DT");
+}
+
+#define relocate_object(object, name)				\
+do {								\
+	extern char object##__start[];				\
+	relocate_reserved(name, object##__start);		\
+} while (0)
+
+void relocate_dt(void)
+{
+	reloc_offset = (unsigned long)text__start - PHYS_OFFSET;
+	if (!reloc_offset)
+		return;
+
+	print_string("Loaded at ");
+	print_ulong_hex((unsigned long)text__start);
+	print_string(" instead of ");
+	print_ulong_hex(PHYS_OFFSET);
+	print_string(", moving the DT layout\r\n");
+
+	/* The kernel needs its 2MB aligned base */
+	if (reloc_offset & (SZ_2M - 1))
+		relocate_fail("the load offset must be a multiple of 2MB");
+
+	relocate_object(text, "boot-wrapper-text");
+	relocate_object(bss, "boot-wrapper");
+#ifdef BOOTLOG
+	relocate_object(bootlog, "ramoops");
+#endif
+#ifdef SMC_STATS
+	relocate_object(smc_stats, "smc-stats");
+#endif
+#ifdef SYSTEM_RESET
+	relocate_object(snapshot, "snapshot");
+#endif
+#ifdef USE_INITRD
+	if (fdt_offset_prop(&dtb, "/chosen", "linux,initrd-start", 2,
+			    (uint64_t)(long)reloc_offset) ||
+	    fdt_offset_prop(&dtb, "/chosen", "linux,initrd-end", 2,
+			    (uint64_t)(long)reloc_offset))
+		relocate_fail("no initrd properties to update");
+#endif
+}
@@ -0,0 +1,102 @@
+/*
+ * semihosting.c - Arm semihosting interface
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#include <semihosting.h>
+
+static unsigned long str_len(const char *str)
+{
+	unsigned long len = 0;
+
+	while (str[len])
+		len++;
+
+	return len;
+}
+
+/**
+ * Open a host file for reading. Return a handle, or -1.
+ */
+long semihosting_open(const char *path)
+{
+	unsigned long block[] = {
+		(unsigned long)path, SEMIHOSTING_OPEN_RB, str_len(path)
+	};
+
+	return semihosting_call(SEMIHOSTING_SYS_OPEN, (unsigned long)block);
+}
+
+int semihosting_close(long handle)
+{
+	unsigned long block[] = { handle };
+
+	return semihosting_call(SEMIHOSTING_SYS_CLOSE, (unsigned long)block);
+}
+
+/**
+ * Return the size of an open file, or -1.
+ */
+long semihosting_flen(long handle)
+{
+	unsigned long block[] = { handle };
+
+	return semihosting_call(SEMIHOSTING_SYS_FLEN, (unsigned long)block);
+}
+
+/**
+ * Read @size bytes at the current position. Return 0 on success, -1 if the
+ * read was short.
+ */
+int semihosting_read(long handle, void *buf, unsigned long size)
+{
+	unsigned long block[] = { handle, (unsigned long)buf, size };
+
+	/* SYS_READ returns the number of bytes *not* read */
+	if (semihosting_call(SEMIHOSTING_SYS_READ, (unsigned long)block))
+		return -1;
+
+	return 0;
+}
+
+/**
+ * Move to absolute position @pos. Return 0 on success, or a negative value.
+ */
+int semihosting_seek(long handle, unsigned long pos)
+{
+	unsigned long block[] = { handle, pos };
+
+	return semihosting_call(SEMIHOSTING_SYS_SEEK, (unsigned long)block);
+}
+
+void semihosting_writec(char c)
+{
+	semihosting_call(SEMIHOSTING_SYS_WRITEC, (unsigned long)&c);
+}
+
+/**
+ * Write a NUL-terminated string to the debug console, in a single call.
+ */
+void semihosting_write0(const char *str)
+{
+	semihosting_call(SEMIHOSTING_SYS_WRITE0, (unsigned long)str);
+}
+
+/**
+ * Ask the debugger or model to stop, reporting an exit code. Only returns if
+ * semihosting isn't handled.
+ */
+void semihosting_exit(unsigned long code)
+{
+	unsigned long block[] = { ADP_STOPPED_APPLICATION_EXIT, code };
+
+#ifdef BOOTWRAPPER_32
+	/* On AArch32, only the extended call takes an exit code */
+	semihosting_call(SEMIHOSTING_SYS_EXIT_EXTENDED, (unsigned long)block);
+#else
+	semihosting_call(SEMIHOSTING_SYS_EXIT, (unsigned long)block);
+#endif
+}
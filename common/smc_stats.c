@@ -0,0 +1,218 @@
+/*
+ * smc_stats.c - SMC call counters and latency histograms
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * The SMC vectors call smc_stats_call() instead of psci_call(), which counts
+ * every call per CPU and per function ID, and adds the time spent in
+ * psci_call() to a histogram with one bucket per power of two CNTPCT ticks.
+ * Calls that don't return, such as CPU_OFF, are counted but not timed.
+ *
+ * The counters live in a region that the DT reserves, laid out as below, so
+ * that they can be read from outside (scripts/smc-stats.pl decodes a dump):
+ *
+ *   header
+ *   live[NR_CPUS][NR_FIDS]	updated on every call
+ *   snapshot[NR_CPUS][NR_FIDS]	copied from live by SIP_SMC_STATS
+ *
+ * All fields are little-endian. Each CPU only updates its own entries, but
+ * the SiP call copies or clears those of other CPUs without synchronisation:
+ * a CPU that is in the middle of a call at the time may be off by one.
+ */
+#include <stdint.h>
+
+#include <cpu.h>
+#include <psci.h>
+#include <smc_stats.h>
+
+#define SMC_STATS_MAGIC		0x53434d53	/* "SMCS" */
+#define SMC_STATS_VERSION	1
+#define SMC_STATS_BUCKETS	24
+
+/* Calls to any function ID missing from the table are accounted here */
+#define SMC_STATS_OTHER		0xffffffff
+
+struct smc_stats_entry {
+	uint32_t fid;
+	uint32_t reserved;
+	uint64_t count;
+	/* Number of timed calls, and their total duration */
+	uint64_t timed;
+	uint64_t ticks;
+	/* Bucket n counts calls of [2^(n-1), 2^n) ticks, the last one more */
+	uint64_t hist[SMC_STATS_BUCKETS];
+};
+
+static const uint32_t smc_stats_fids[] = {
+	PSCI_VERSION,
+	PSCI_CPU_OFF,
+	PSCI_CPU_ON_32,
+	PSCI_CPU_ON_64,
+	PSCI_AFFINITY_INFO_32,
+	PSCI_AFFINITY_INFO_64,
+	PSCI_MIGRATE_INFO_TYPE,
+	PSCI_FEATURES,
+	PSCI_SYSTEM_OFF,
+	PSCI_SYSTEM_RESET,
+	PSCI_SYSTEM_RESET2_32,
+	PSCI_SYSTEM_RESET2_64,
+	SIP_SMC_STATS,
+	SIP_CPU_ON_BATCH_32,
+	SIP_CPU_ON_BATCH_64,
+	SMCCC_VERSION,
+	TRNG_RND_64,
+	SMC_STATS_OTHER,
+};
+
+#define NR_FIDS		(sizeof(smc_stats_fids) / sizeof(smc_stats_fids[0]))
+
+struct smc_stats {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nr_cpus;
+	uint32_t nr_fids;
+	uint32_t nr_buckets;
+	uint32_t entry_size;
+	uint64_t counter_freq;
+	/* CNTPCT at the last snapshot and reset */
+	uint64_t snapshot_time;
+	uint64_t reset_time;
+	struct smc_stats_entry live[NR_CPUS][NR_FIDS];
+	struct smc_stats_entry snapshot[NR_CPUS][NR_FIDS];
+};
+
+_Static_assert(sizeof(struct smc_stats) <= SMC_STATS_SIZE,
+	       "SMC statistics overflow their region");
+
+/* Provided by the linker script */
+extern volatile struct smc_stats smc_stats;
+
+long psci_call(unsigned long fid, unsigned long arg1, unsigned long arg2,
+	       unsigned long arg3, unsigned long *res);
+
+static void entry_clear(volatile struct smc_stats_entry *entry, uint32_t fid)
+{
+	unsigned int i;
+
+	entry->fid = fid;
+	entry->reserved = 0;
+	entry->count = 0;
+	entry->timed = 0;
+	entry->ticks = 0;
+	for (i = 0; i < SMC_STATS_BUCKETS; i++)
+		entry->hist[i] = 0;
+}
+
+static void entry_copy(volatile struct smc_stats_entry *dst,
+		       volatile struct smc_stats_entry *src)
+{
+	unsigned int i;
+
+	dst->fid = src->fid;
+	dst->count = src->count;
+	dst->timed = src->timed;
+	dst->ticks = src->ticks;
+	for (i = 0; i < SMC_STATS_BUCKETS; i++)
+		dst->hist[i] = src->hist[i];
+}
+
+static void smc_stats_reset(void)
+{
+	unsigned int cpu, i;
+
+	for (cpu = 0; cpu < NR_CPUS; cpu++)
+		for (i = 0; i < NR_FIDS; i++)
+			entry_clear(&smc_stats.live[cpu][i], smc_stats_fids[i]);
+
+	smc_stats.reset_time = read_counter();
+}
+
+void smc_stats_init(void)
+{
+	unsigned int cpu, i;
+
+	smc_stats.version = SMC_STATS_VERSION;
+	smc_stats.nr_cpus = NR_CPUS;
+	smc_stats.nr_fids = NR_FIDS;
+	smc_stats.nr_buckets = SMC_STATS_BUCKETS;
+	smc_stats.entry_size = sizeof(struct smc_stats_entry);
+	smc_stats.counter_freq = COUNTER_FREQ;
+	smc_stats.snapshot_time = 0;
+
+	for (cpu = 0; cpu < NR_CPUS; cpu++)
+		for (i = 0; i < NR_FIDS; i++)
+			entry_clear(&smc_stats.snapshot[cpu][i], smc_stats_fids[i]);
+
+	smc_stats_reset();
+
+	dsb(sy);
+	smc_stats.magic = SMC_STATS_MAGIC;
+}
+
+long smc_stats_control(unsigned long op)
+{
+	unsigned int cpu, i;
+
+	switch (op) {
+	case SMC_STATS_SNAPSHOT:
+		for (cpu = 0; cpu < NR_CPUS; cpu++)
+			for (i = 0; i < NR_FIDS; i++)
+				entry_copy(&smc_stats.snapshot[cpu][i],
+					   &smc_stats.live[cpu][i]);
+		smc_stats.snapshot_time = read_counter();
+		return PSCI_RET_SUCCESS;
+	case SMC_STATS_RESET:
+		smc_stats_reset();
+		return PSCI_RET_SUCCESS;
+	default:
+		return PSCI_RET_INVALID_PARAMETERS;
+	}
+}
+
+static unsigned int fid_index(unsigned long fid)
+{
+	unsigned int i;
+
+	for (i = 0; i < NR_FIDS - 1; i++)
+		if (smc_stats_fids[i] == fid)
+			break;
+
+	return i;
+}
+
+static unsigned int bucket(uint64_t ticks)
+{
+	unsigned int n = 0;
+
+	while (ticks && n < SMC_STATS_BUCKETS - 1) {
+		ticks >>= 1;
+		n++;
+	}
+
+	return n;
+}
+
+long smc_stats_call(unsigned long fid, unsigned long arg1, unsigned long arg2,
+		    unsigned long arg3, unsigned long *res)
+{
+	volatile struct smc_stats_entry *entry;
+	uint64_t start, ticks;
+	long ret;
+
+	entry = &smc_stats.live[this_cpu_logical_id()][fid_index(fid)];
+	entry->count++;
+
+	start = read_counter();
+	ret = psci_call(fid, arg1, arg2, arg3, res);
+	ticks = read_counter() - start;
+
+	entry->timed++;
+	entry->ticks += ticks;
+	entry->hist[bucket(ticks)]++;
+
+	return ret;
+}
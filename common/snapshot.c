@@ -0,0 +1,122 @@
+/*
+ * snapshot.c - pristine copy of the boot images
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * On first boot, the primary CPU copies the kernel, DTB, initrd, Xen and the
+ * boot-wrapper's own data into a region that the DT reserves. SYSTEM_RESET
+ * copies them back, so that after the platform reset the CPUs find memory
+ * exactly as the model loaded it. The restored .data says .bss is dirty, which
+ * has the primary CPU zero it again.
+ *
+ * A snapshot is only taken when .data says there is none, which it does as
+ * loaded. DRAM can't be trusted to tell: a debugger may load new images over
+ * an old snapshot.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpu.h>
+#include <snapshot.h>
+
+struct snapshot_region {
+	char *start;
+	char *end;
+};
+
+extern char snapshot__start[];
+
+extern char kernel__start[], kernel__end[];
+extern char dtb__start[], dtb__end[];
+extern char xen__start[], xen__end[];
+extern char filesystem__start[], filesystem__end[];
+extern char data__start[], data__end[];
+
+static const struct snapshot_region regions[] = {
+	{ kernel__start, kernel__end },
+	{ dtb__start, dtb__end },
+#ifdef XEN
+	{ xen__start, xen__end },
+#endif
+#ifdef USE_INITRD
+	{ filesystem__start, filesystem__end },
+#endif
+	{ data__start, data__end },
+};
+
+#define NR_REGIONS	(sizeof(regions) / sizeof(regions[0]))
+
+/* In .data: cleared once taken, and again once restored */
+static volatile bool snapshot_missing = true;
+
+/*
+ * With the MMU off every access is Device, which must be aligned: copy whole
+ * words, then the remaining bytes. All regions start on a word boundary.
+ */
+static void copy(char *dst, const char *src, unsigned long size)
+{
+	unsigned long i;
+
+	for (i = 0; i + sizeof(long) <= size; i += sizeof(long))
+		*(unsigned long *)(dst + i) = *(const unsigned long *)(src + i);
+
+	for (; i < size; i++)
+		dst[i] = src[i];
+}
+
+/* Size of a region in the snapshot, keeping the next one aligned */
+static unsigned long region_size(const struct snapshot_region *region)
+{
+	unsigned long size = region->end - region->start;
+
+	return (size + sizeof(long) - 1) & ~(sizeof(long) - 1);
+}
+
+void snapshot_take(void)
+{
+	char *dst = snapshot__start;
+	int i;
+
+	if (!snapshot_missing)
+		return;
+
+	for (i = 0; i < NR_REGIONS; i++) {
+		copy(dst, regions[i].start, regions[i].end - regions[i].start);
+		dst += region_size(&regions[i]);
+	}
+
+	snapshot_missing = false;
+
+	/* With the EL2 MPU on, the snapshot must reach memory before any reset */
+	dcache_clean_inval_range((unsigned long)snapshot__start,
+				 (unsigned long)dst);
+}
+
+/*
+ * The kernel ran with its caches on: make sure none of its dirty lines can be
+ * written back over the restored images. With the EL2 MPU on, as on Armv8-R,
+ * the copies are cached too, and must reach memory before the reset.
+ */
+void snapshot_restore(void)
+{
+	const char *src = snapshot__start;
+	int i;
+
+	for (i = 0; i < NR_REGIONS; i++) {
+		dcache_clean_inval_range((unsigned long)regions[i].start,
+					 (unsigned long)regions[i].end);
+		copy(regions[i].start, src, regions[i].end - regions[i].start);
+		dcache_clean_inval_range((unsigned long)regions[i].start,
+					 (unsigned long)regions[i].end);
+		src += region_size(&regions[i]);
+	}
+
+	/* The restored .data is the one that had no snapshot yet */
+	snapshot_missing = false;
+	dcache_clean_inval_range((unsigned long)&snapshot_missing,
+				 (unsigned long)(&snapshot_missing + 1));
+}
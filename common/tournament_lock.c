@@ -0,0 +1,75 @@
+/*
+ * tournament_lock.c - Tournament tree of Peterson locks
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Each CPU climbs a binary tree from its leaf to the root, winning one
+ * two-CPU Peterson lock [1] per level. An acquisition therefore costs
+ * O(log2(NR_CPUS)) accesses instead of the O(NR_CPUS) scans of the bakery lock.
+ *
+ * Like the bakery lock, this algorithm only relies on single-copy atomicity of
+ * 16-bit reads and writes, so it may be used on Device memory with
+ * non-gathering and non-reordering attributes. Barriers are still issued
+ * between the two doorway writes, and between them and the reads, so that it
+ * also behaves on Normal memory.
+ *
+ * [1] Peterson, G. L. "Myths About the Mutual Exclusion Problem"
+ */
+
+#include <cpu.h>
+#include <tournament_lock.h>
+
+void tournament_lock(tournament_lock_t *lock, unsigned self)
+{
+	unsigned int node = NR_CPUS + self;
+
+	while (node > 1) {
+		struct tournament_match *match = &lock->matches[node / 2];
+		unsigned int side = node & 1;
+
+		match->flag[side] = 1;
+		dmb(sy);
+		match->victim = side;
+
+		/*
+		 * Orders the doorway before the reads below, and wakes an
+		 * opponent that went to sleep before we wrote the victim: only
+		 * an event gets it out of wfe().
+		 */
+		dsb(sy);
+		sev();
+
+		while (match->flag[!side] && match->victim == side)
+			wfe();
+
+		node /= 2;
+	}
+
+	dmb(sy);
+}
+
+void tournament_unlock(tournament_lock_t *lock, unsigned self)
+{
+	unsigned int leaf = NR_CPUS + self;
+	int level = 31 - clz(leaf);
+
+	dmb(sy);
+
+	/*
+	 * Release from the root down: releasing a lower match first would let
+	 * a CPU from our own subtree take our side of an upper match, and our
+	 * release would then clear its flag.
+	 */
+	while (level--) {
+		unsigned int node = leaf >> level;
+
+		lock->matches[node / 2].flag[node & 1] = 0;
+	}
+
+	dsb(st);
+	sev();
+}
@@ -26,6 +26,9 @@ typedef union {
 	uint16_t __val;
 } bakery_ticket_t;
 
+/* Largest value that fits in bakery_ticket_t.number */
+#define BAKERY_NUMBER_MAX	0x7fff
+
 #define write_ticket_once(ticket, choosing_, number_)			\
 ({									\
 	bakery_ticket_t __t = {						\
@@ -42,7 +45,7 @@ typedef union {
 	__t;								\
 })
 
-void bakery_lock(bakery_ticket_t *tickets, unsigned self);
+unsigned int bakery_lock(bakery_ticket_t *tickets, unsigned self);
 void bakery_unlock(bakery_ticket_t *tickets, unsigned self);
 
 #endif
@@ -12,6 +12,24 @@
 #include <compiler.h>
 #include <stdbool.h>
 
+extern unsigned long entrypoint;
+extern unsigned long dtb;
+
+extern const unsigned long id_table[];
+
+#ifdef SEMIHOSTING_LOADER
+#include <loader.h>
+#define kernel_entrypoint()	loader_entrypoint
+#else
+#define kernel_entrypoint()	((unsigned long)&entrypoint)
+#endif
+
+void __noreturn jump_kernel(unsigned long address,
+			    unsigned long a0,
+			    unsigned long a1,
+			    unsigned long a2,
+			    unsigned long a3);
+
 void __noreturn spin(unsigned long *mbox, unsigned long invalid);
 
 void __noreturn first_spin(unsigned int cpu, unsigned long *mbox,
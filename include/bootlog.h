@@ -0,0 +1,15 @@
+/*
+ * include/bootlog.h - in-memory boot log
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __BOOTLOG_H
+#define __BOOTLOG_H
+
+void bootlog_init(void);
+void bootlog_putc(char c);
+
+#endif
@@ -20,6 +20,7 @@
 #define dsb(arg)	asm volatile ("dsb " #arg "\n" : : : "memory")
 #define sev()		asm volatile ("sev\n" : : : "memory")
 #define wfe()		asm volatile ("wfe\n" : : : "memory")
+#define wfi()		asm volatile ("wfi\n" : : : "memory")
 
 #define clz(val)	__builtin_clz(val)
 
@@ -27,5 +28,7 @@ unsigned int find_logical_id(unsigned long mpidr);
 
 #define this_cpu_logical_id()	find_logical_id(read_mpidr())
 
+void dcache_clean_inval_range(unsigned long start, unsigned long end);
+
 #endif /* !__ASSEMBLY__ */
 #endif
@@ -0,0 +1,21 @@
+/*
+ * include/fdt.h - minimal flattened device tree access
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __FDT_H
+#define __FDT_H
+
+#include <stdint.h>
+
+void *fdt_find_prop(void *fdt, const char *path, const char *name,
+		    uint32_t *len);
+int fdt_set_prop_u64s(void *fdt, const char *path, const char *name,
+		      const uint64_t *vals, unsigned int count);
+int fdt_offset_prop(void *fdt, const char *path, const char *name,
+		    unsigned int cells, uint64_t offset);
+
+#endif
@@ -0,0 +1,16 @@
+/*
+ * include/loader.h - load the payloads over semihosting
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __LOADER_H
+#define __LOADER_H
+
+extern unsigned long loader_entrypoint;
+
+void loader_load(void);
+
+#endif
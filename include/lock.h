@@ -0,0 +1,46 @@
+/*
+ * include/lock.h - lock algorithm selected at build time
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __LOCK_H
+#define __LOCK_H
+
+#if defined(LOCK_MCS)
+
+#include <mcs_lock.h>
+
+/* The MCS lock needs exclusives, so callers may rely on them as well */
+#define LOCK_HAS_EXCLUSIVES
+
+typedef mcs_lock_t lock_t;
+
+#define lock_acquire(lock, self)	mcs_lock(lock, self)
+#define lock_release(lock, self)	mcs_unlock(lock, self)
+
+#elif defined(LOCK_TOURNAMENT)
+
+#include <tournament_lock.h>
+
+typedef tournament_lock_t lock_t;
+
+#define lock_acquire(lock, self)	tournament_lock(lock, self)
+#define lock_release(lock, self)	tournament_unlock(lock, self)
+
+#else
+
+#include <bakery_lock.h>
+
+typedef struct {
+	bakery_ticket_t tickets[NR_CPUS];
+} lock_t;
+
+#define lock_acquire(lock, self)	bakery_lock((lock)->tickets, self)
+#define lock_release(lock, self)	bakery_unlock((lock)->tickets, self)
+
+#endif
+
+#endif
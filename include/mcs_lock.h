@@ -0,0 +1,29 @@
+/*
+ * include/mcs_lock.h
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __MCS_LOCK_H
+#define __MCS_LOCK_H
+
+struct mcs_node {
+	volatile unsigned long next;
+	volatile unsigned long locked;
+};
+
+/*
+ * Queue nodes are indexed by logical ID. tail and next hold (logical ID + 1),
+ * so that zero means "no CPU".
+ */
+typedef struct {
+	unsigned long tail;
+	struct mcs_node nodes[NR_CPUS];
+} mcs_lock_t;
+
+void mcs_lock(mcs_lock_t *lock, unsigned self);
+void mcs_unlock(mcs_lock_t *lock, unsigned self);
+
+#endif
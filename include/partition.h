@@ -0,0 +1,20 @@
+/*
+ * include/partition.h - independent kernels on disjoint sets of CPUs
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __PARTITION_H
+#define __PARTITION_H
+
+#include <stdbool.h>
+
+bool partition_is_boot_cpu(unsigned int cpu);
+bool same_partition(unsigned int cpu, unsigned int other);
+unsigned long partition_entrypoint(unsigned int cpu);
+unsigned long partition_dtb(unsigned int cpu);
+bool partition_system_off(unsigned int cpu);
+
+#endif
@@ -9,16 +9,27 @@
 #ifndef __PLATFORM_H
 #define __PLATFORM_H
 
+#include <compiler.h>
+#include <stdbool.h>
+
 void print_char(char c);
 void print_string(const char *str);
 void print_ulong_hex(unsigned long val);
 void print_uint_dec(unsigned int val);
+void print_ulong_dec(unsigned long val);
 
 void print_cpu_warn(unsigned int cpu, const char *str);
 void print_cpu_msg(unsigned int cpu, const char *str);
 
-void init_uart(void);
+void init_console(void);
 
 void init_platform(void);
 
+void __noreturn platform_cpu_off(unsigned long mpidr);
+void platform_cpu_on(unsigned int self, unsigned long mpidr);
+bool platform_cpu_woken(void);
+
+void __noreturn platform_system_reset(void);
+void __noreturn platform_system_off(void);
+
 #endif /* __PLATFORM_H */
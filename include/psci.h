@@ -9,9 +9,65 @@
 #ifndef __PSCI_H
 #define __PSCI_H
 
+#define PSCI_VERSION			0x84000000
+#define PSCI_CPU_SUSPEND_32		0x84000001
+#define PSCI_CPU_SUSPEND_64		0xc4000001
 #define PSCI_CPU_OFF			0x84000002
 #define PSCI_CPU_ON_32			0x84000003
 #define PSCI_CPU_ON_64			0xc4000003
+#define PSCI_AFFINITY_INFO_32		0x84000004
+#define PSCI_AFFINITY_INFO_64		0xc4000004
+#define PSCI_MIGRATE_INFO_TYPE		0x84000006
+#define PSCI_SYSTEM_OFF			0x84000008
+#define PSCI_SYSTEM_RESET		0x84000009
+#define PSCI_FEATURES			0x8400000a
+#define PSCI_STAT_RESIDENCY_32		0x84000010
+#define PSCI_STAT_RESIDENCY_64		0xc4000010
+#define PSCI_STAT_COUNT_32		0x84000011
+#define PSCI_STAT_COUNT_64		0xc4000011
+#define PSCI_SYSTEM_RESET2_32		0x84000012
+#define PSCI_SYSTEM_RESET2_64		0xc4000012
+
+/*
+ * SiP fast call: CPU_ON for every CPU whose MPIDR matches target_affinity
+ * (arg1) from affinity level lowest_level (arg3) up, all entering at arg2.
+ */
+#define SIP_CPU_ON_BATCH_32		0x8200ff01
+#define SIP_CPU_ON_BATCH_64		0xc200ff01
+
+/* SMCCC v1.1: the kernel only looks for the TRNG past v1.0 */
+#define SMCCC_VERSION			0x80000000
+#define SMCCC_ARCH_FEATURES		0x80000001
+#define SMCCC_VERSION_VALUE		((1 << 16) | 1)
+
+/* SMCCC TRNG v1.0 */
+#define TRNG_VERSION			0x84000050
+#define TRNG_FEATURES			0x84000051
+#define TRNG_GET_UUID			0x84000052
+#define TRNG_RND_32			0x84000053
+#define TRNG_RND_64			0xc4000053
+#define TRNG_VERSION_VALUE		(1 << 16)
+#define TRNG_RET_NO_ENTROPY		(-3)
+
+/* PSCI v1.1 */
+#define PSCI_VERSION_VALUE		((1 << 16) | 1)
+
+#define PSCI_AFFINITY_ON		0
+#define PSCI_AFFINITY_OFF		1
+#define PSCI_AFFINITY_ON_PENDING	2
+
+/* Trusted OS not present, or doesn't require migration */
+#define PSCI_MIGRATE_INFO_NONE		2
+
+/* power_state parameters, in the original format */
+#define PSCI_POWER_STATE_POWERDOWN	(1 << 16)
+/* The only state CPU_SUSPEND enters: standby, level 0, StateID 0 */
+#define PSCI_POWER_STATE_STANDBY	0
+/* What CPU_OFF enters: power down, level 0, StateID 0 */
+#define PSCI_POWER_STATE_CPU_OFF	PSCI_POWER_STATE_POWERDOWN
+
+#define PSCI_RESET2_VENDOR		(1U << 31)
+#define PSCI_RESET2_WARM		0
 
 #define PSCI_RET_SUCCESS		0
 #define PSCI_RET_NOT_SUPPORTED		(-1)
@@ -0,0 +1,14 @@
+/*
+ * include/reloc.h - position-independent boot-wrapper
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __RELOC_H
+#define __RELOC_H
+
+void relocate_dt(void);
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * include/rng.h - entropy for the kernel
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __RNG_H
+#define __RNG_H
+
+void rng_seed_dt(void);
+
+long trng_version(void);
+long trng_features(unsigned long fid);
+long trng_get_uuid(unsigned long *res);
+long trng_rnd(unsigned long bits, unsigned int reg_bits, unsigned long *res);
+
+#endif
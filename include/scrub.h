@@ -0,0 +1,14 @@
+/*
+ * include/scrub.h - zero memory before the kernel boots
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __SCRUB_H
+#define __SCRUB_H
+
+void scrub_memory(unsigned int cpu);
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * include/semihosting.h - Arm semihosting interface
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __SEMIHOSTING_H
+#define __SEMIHOSTING_H
+
+#include <asm/semihosting.h>
+
+#define SEMIHOSTING_SYS_OPEN		0x01
+#define SEMIHOSTING_SYS_CLOSE		0x02
+#define SEMIHOSTING_SYS_WRITEC		0x03
+#define SEMIHOSTING_SYS_WRITE0		0x04
+#define SEMIHOSTING_SYS_READ		0x06
+#define SEMIHOSTING_SYS_SEEK		0x0a
+#define SEMIHOSTING_SYS_FLEN		0x0c
+#define SEMIHOSTING_SYS_EXIT		0x18
+#define SEMIHOSTING_SYS_EXIT_EXTENDED	0x20
+
+#define ADP_STOPPED_APPLICATION_EXIT	0x20026
+
+/* fopen() mode "rb" */
+#define SEMIHOSTING_OPEN_RB		1
+
+long semihosting_open(const char *path);
+int semihosting_close(long handle);
+long semihosting_flen(long handle);
+int semihosting_read(long handle, void *buf, unsigned long size);
+int semihosting_seek(long handle, unsigned long pos);
+
+void semihosting_writec(char c);
+void semihosting_write0(const char *str);
+
+void semihosting_exit(unsigned long code);
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * include/smc_stats.h - SMC call counters and latency histograms
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __SMC_STATS_H
+#define __SMC_STATS_H
+
+/* SMC32 fast call in the SiP range, arg1 selects the operation */
+#define SIP_SMC_STATS			0x8200ff00
+#define SMC_STATS_SNAPSHOT		0
+#define SMC_STATS_RESET			1
+
+#ifndef __ASSEMBLY__
+
+void smc_stats_init(void);
+long smc_stats_call(unsigned long fid, unsigned long arg1, unsigned long arg2,
+		    unsigned long arg3, unsigned long *res);
+long smc_stats_control(unsigned long op);
+
+#endif /* !__ASSEMBLY__ */
+
+#endif
@@ -0,0 +1,15 @@
+/*
+ * include/snapshot.h - pristine copy of the boot images
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __SNAPSHOT_H
+#define __SNAPSHOT_H
+
+void snapshot_take(void);
+void snapshot_restore(void);
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * include/tournament_lock.h
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __TOURNAMENT_LOCK_H
+#define __TOURNAMENT_LOCK_H
+
+#include <stdint.h>
+
+/*
+ * As for the bakery lock, these fields *must* be accessed with 16-bit accesses,
+ * since the lock may live in Device memory.
+ */
+struct tournament_match {
+	volatile uint16_t flag[2];
+	volatile uint16_t victim;
+};
+
+/*
+ * Binary tree of two-CPU Peterson locks, stored as an implicit heap: match n
+ * has children 2n and 2n + 1, and CPU i starts from leaf NR_CPUS + i. Entry 0
+ * is unused.
+ */
+typedef struct {
+	struct tournament_match matches[NR_CPUS];
+} tournament_lock_t;
+
+void tournament_lock(tournament_lock_t *lock, unsigned self);
+void tournament_unlock(tournament_lock_t *lock, unsigned self);
+
+#endif
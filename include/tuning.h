@@ -0,0 +1,14 @@
+/*
+ * include/tuning.h - per-core IMPLEMENTATION DEFINED settings
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __TUNING_H
+#define __TUNING_H
+
+void cpu_tune(unsigned int cpu);
+
+#endif
@@ -0,0 +1,15 @@
+/*
+ * include/xip.h - execute in place from flash
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ */
+#ifndef __XIP_H
+#define __XIP_H
+
+void xip_copy_data(void);
+void xip_copy_payloads(unsigned int cpu);
+
+#endif
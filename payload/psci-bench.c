@@ -0,0 +1,693 @@
+/*
+ * psci-bench.c - bare-metal PSCI latency benchmark
+ *
+ * Copyright (C) 2026 ARM Limited. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE.txt file.
+ *
+ *
+ * Stands in for the kernel image, and measures the cost of the boot-wrapper's
+ * PSCI implementation without any kernel noise:
+ *
+ * - SMC round-trips for a call that doesn't change any state,
+ * - CPU_ON/CPU_OFF cycles against every secondary,
+ * - bringing up all secondaries at once, then all CPUs issuing CPU_ON
+ *   concurrently,
+ * - bringing up all secondaries with one CPU_ON per CPU, then with a single
+ *   batched call,
+ * - all CPUs hammering each of the boot-wrapper's lock algorithms for a fixed
+ *   time: total acquisitions, and their spread between CPUs for fairness. A
+ *   shared counter, only updated under the lock, checks mutual exclusion. One
+ *   more bakery round starts with every ticket just below BAKERY_NUMBER_MAX,
+ *   so that the doorway runs out of numbers and has to back off.
+ *
+ * The bakery and tournament locks are measured on Device memory, with the MMU
+ * off as in the boot-wrapper. The MCS lock needs exclusives, so for its round
+ * each CPU maps the payload as Normal memory with an EL2 identity map, and
+ * leaves it on: that round comes last.
+ *
+ * All times are measured with CNTPCT_EL0, which is common to all CPUs. The PMU
+ * cycle counter isn't used: with MDCR_EL3.SPME clear, it doesn't count while
+ * the boot-wrapper runs at EL3.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <bakery_lock.h>
+#include <cpu.h>
+#include <mcs_lock.h>
+#include <platform.h>
+#include <psci.h>
+#include <tournament_lock.h>
+
+#ifndef BENCH_SMC_ITERATIONS
+#define BENCH_SMC_ITERATIONS	1000
+#endif
+
+#ifndef BENCH_CYCLE_ITERATIONS
+#define BENCH_CYCLE_ITERATIONS	10
+#endif
+
+#ifndef BENCH_STORM_ITERATIONS
+#define BENCH_STORM_ITERATIONS	100
+#endif
+
+/* Length of each lock round, in CNTPCT ticks */
+#ifndef BENCH_LOCK_TICKS
+#define BENCH_LOCK_TICKS	(COUNTER_FREQ / 100)
+#endif
+
+#define BLOCK_SHIFT		30
+#define VA_BITS			39
+#define NR_BLOCKS		(UL(1) << (VA_BITS - BLOCK_SHIFT))
+
+#define PTE_BLOCK		BIT(0)
+#define PTE_ATTRINDX(idx)	((idx) << 2)
+#define PTE_SH_INNER		(UL(3) << 8)
+#define PTE_AF			BIT(10)
+
+#define ATTR_DEVICE		0
+#define ATTR_NORMAL		1
+
+const unsigned long bench_id_table[] = { CPU_IDS };
+
+void secondary_entry(void);
+
+enum bench_mode {
+	BENCH_CYCLE,
+	BENCH_STORM,
+	BENCH_BATCH,
+	BENCH_LOCK,
+};
+
+struct bench_stats {
+	unsigned long count;
+	unsigned long min;
+	unsigned long max;
+	unsigned long sum;
+};
+
+static volatile enum bench_mode bench_mode;
+
+/* Written by secondaries, in CNTPCT ticks */
+static volatile unsigned long arrived[NR_CPUS];
+static volatile unsigned long leaving[NR_CPUS];
+
+static volatile unsigned int storm_go;
+static volatile unsigned int storm_over;
+static volatile unsigned int storm_done[NR_CPUS];
+static struct bench_stats storm_stats[NR_CPUS];
+
+static bakery_ticket_t bench_bakery[NR_CPUS];
+static tournament_lock_t bench_tournament;
+static mcs_lock_t bench_mcs;
+
+static volatile unsigned long lock_backoffs[NR_CPUS];
+
+static void bakery_acquire(unsigned int cpu)
+{
+	unsigned int backoffs = bakery_lock(bench_bakery, cpu);
+
+	if (backoffs)
+		lock_backoffs[cpu] += backoffs;
+}
+
+/*
+ * Each CPU overwrites its stale ticket when it first enters the doorway, and
+ * until then only holds up CPUs that drew the highest number. The first CPUs
+ * to contend draw that number, and the next ones run out.
+ */
+static void bakery_overflow(void)
+{
+	unsigned int cpu;
+
+	for (cpu = 0; cpu < NR_CPUS; cpu++)
+		write_ticket_once(bench_bakery[cpu], 0, BAKERY_NUMBER_MAX - 1);
+}
+
+static void bakery_release(unsigned int cpu)
+{
+	bakery_unlock(bench_bakery, cpu);
+}
+
+static void tournament_acquire(unsigned int cpu)
+{
+	tournament_lock(&bench_tournament, cpu);
+}
+
+static void tournament_release(unsigned int cpu)
+{
+	tournament_unlock(&bench_tournament, cpu);
+}
+
+static void mcs_acquire(unsigned int cpu)
+{
+	mcs_lock(&bench_mcs, cpu);
+}
+
+static void mcs_release(unsigned int cpu)
+{
+	mcs_unlock(&bench_mcs, cpu);
+}
+
+struct bench_lock {
+	const char *name;
+	void (*acquire)(unsigned int cpu);
+	void (*release)(unsigned int cpu);
+	/* Optional, called before the secondaries are started */
+	void (*prepare)(void);
+	/* Needs Normal memory */
+	bool mmu;
+};
+
+/* The round with the MMU on comes last */
+static const struct bench_lock bench_locks[] = {
+	{ "bakery", bakery_acquire, bakery_release, NULL, false },
+	{ "bakery overflow", bakery_acquire, bakery_release, bakery_overflow,
+	  false },
+	{ "tournament", tournament_acquire, tournament_release, NULL, false },
+	{ "mcs", mcs_acquire, mcs_release, NULL, true },
+};
+
+#define NR_BENCH_LOCKS	(sizeof(bench_locks) / sizeof(bench_locks[0]))
+
+static const struct bench_lock *volatile lock_round;
+static volatile unsigned long lock_deadline;
+static volatile unsigned int lock_go;
+static volatile unsigned int lock_done[NR_CPUS];
+static volatile unsigned long lock_count[NR_CPUS];
+/* Only updated under the lock, with a non-atomic increment */
+static volatile unsigned long lock_counter;
+
+static uint64_t page_table[NR_BLOCKS] __attribute__((aligned(4096)));
+
+static unsigned long psci_invoke(unsigned long fid, unsigned long arg1,
+				 unsigned long arg2, unsigned long arg3)
+{
+	register unsigned long x0 asm("x0") = fid;
+	register unsigned long x1 asm("x1") = arg1;
+	register unsigned long x2 asm("x2") = arg2;
+	register unsigned long x3 asm("x3") = arg3;
+
+	asm volatile (
+#ifdef BOOTWRAPPER_64R
+		"hvc	#0\n"
+#else
+		"smc	#0\n"
+#endif
+		: "+r" (x0), "+r" (x1), "+r" (x2), "+r" (x3)
+		:
+		: "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11",
+		  "x12", "x13", "x14", "x15", "x16", "x17", "memory");
+
+	return x0;
+}
+
+static long cpu_on(unsigned int cpu)
+{
+	return psci_invoke(PSCI_CPU_ON_64, bench_id_table[cpu],
+			   (unsigned long)secondary_entry, 0);
+}
+
+static void stats_init(struct bench_stats *stats)
+{
+	stats->count = 0;
+	stats->min = ~0UL;
+	stats->max = 0;
+	stats->sum = 0;
+}
+
+static void stats_add(struct bench_stats *stats, unsigned long ticks)
+{
+	stats->count++;
+	stats->sum += ticks;
+	if (ticks < stats->min)
+		stats->min = ticks;
+	if (ticks > stats->max)
+		stats->max = ticks;
+}
+
+static void stats_merge(struct bench_stats *stats,
+			const struct bench_stats *other)
+{
+	stats->count += other->count;
+	stats->sum += other->sum;
+	if (other->min < stats->min)
+		stats->min = other->min;
+	if (other->max > stats->max)
+		stats->max = other->max;
+}
+
+static void print_ticks(unsigned long ticks)
+{
+	print_ulong_dec(ticks);
+	print_string(" (");
+	print_ulong_dec(ticks * 1000000000UL / COUNTER_FREQ);
+	print_string("ns)");
+}
+
+static void print_stats(const char *name, const struct bench_stats *stats)
+{
+	print_string(name);
+	print_string(": ");
+
+	if (!stats->count) {
+		print_string("no samples\r\n");
+		return;
+	}
+
+	print_ulong_dec(stats->count);
+	print_string(" samples, min ");
+	print_ticks(stats->min);
+	print_string(", avg ");
+	print_ticks(stats->sum / stats->count);
+	print_string(", max ");
+	print_ticks(stats->max);
+	print_string(" ticks\r\n");
+}
+
+static void bench_smc(void)
+{
+	struct bench_stats stats;
+	int i;
+
+	stats_init(&stats);
+
+	for (i = 0; i < BENCH_SMC_ITERATIONS; i++) {
+		unsigned long start = read_counter();
+
+		psci_invoke(PSCI_VERSION, 0, 0, 0);
+		stats_add(&stats, read_counter() - start);
+	}
+
+	print_stats("SMC round-trip", &stats);
+}
+
+/*
+ * Issue CPU_ON until it succeeds, the target may still be on its way down from
+ * a previous CPU_OFF. Return the counter value at the successful call.
+ */
+static long cpu_on_retry(unsigned int cpu, unsigned long *start)
+{
+	long ret;
+
+	do {
+		*start = read_counter();
+		ret = cpu_on(cpu);
+	} while (ret == PSCI_RET_ALREADY_ON || ret == PSCI_RET_ON_PENDING);
+
+	return ret;
+}
+
+static void bench_cycle(void)
+{
+	struct bench_stats on_stats, off_stats;
+	unsigned int cpu;
+	int i;
+
+	stats_init(&on_stats);
+	stats_init(&off_stats);
+	bench_mode = BENCH_CYCLE;
+
+	for (cpu = 1; cpu < NR_CPUS; cpu++) {
+		for (i = 0; i < BENCH_CYCLE_ITERATIONS; i++) {
+			unsigned long start;
+			long ret;
+
+			arrived[cpu] = 0;
+			ret = cpu_on_retry(cpu, &start);
+			if (ret != PSCI_RET_SUCCESS) {
+				print_cpu_warn(cpu, "CPU_ON failed\r\n");
+				break;
+			}
+
+			/* Time from going down to being accepted again */
+			if (i)
+				stats_add(&off_stats, start - leaving[cpu]);
+
+			while (!arrived[cpu])
+				;
+
+			stats_add(&on_stats, arrived[cpu] - start);
+		}
+	}
+
+	print_stats("CPU_ON to entry", &on_stats);
+	print_stats("CPU_OFF to next CPU_ON", &off_stats);
+}
+
+static void storm(unsigned int cpu)
+{
+	unsigned int target = (cpu + 1) % NR_CPUS;
+	struct bench_stats *stats = &storm_stats[cpu];
+	int i;
+
+	stats_init(stats);
+
+	while (!storm_go)
+		;
+
+	/*
+	 * The target is already on, so this only measures the cost of finding
+	 * its slot taken and rejecting the call.
+	 */
+	for (i = 0; i < BENCH_STORM_ITERATIONS; i++) {
+		unsigned long start = read_counter();
+
+		cpu_on(target);
+		stats_add(stats, read_counter() - start);
+	}
+
+	dmb(sy);
+	storm_done[cpu] = 1;
+}
+
+static void bench_storm(void)
+{
+	struct bench_stats stats;
+	unsigned long start, last;
+	unsigned int cpu;
+
+	bench_mode = BENCH_STORM;
+	storm_go = 0;
+	storm_over = 0;
+
+	for (cpu = 0; cpu < NR_CPUS; cpu++) {
+		arrived[cpu] = 0;
+		storm_done[cpu] = 0;
+	}
+
+	start = read_counter();
+	for (cpu = 1; cpu < NR_CPUS; cpu++) {
+		unsigned long ignored;
+
+		if (cpu_on_retry(cpu, &ignored) != PSCI_RET_SUCCESS)
+			print_cpu_warn(cpu, "CPU_ON failed\r\n");
+	}
+
+	last = start;
+	for (cpu = 1; cpu < NR_CPUS; cpu++) {
+		while (!arrived[cpu])
+			;
+		if (arrived[cpu] > last)
+			last = arrived[cpu];
+	}
+
+	print_string("Bring-up of all secondaries: ");
+	print_ticks(last - start);
+	print_string(" ticks\r\n");
+
+	storm_go = 1;
+	storm(0);
+
+	stats_init(&stats);
+	for (cpu = 0; cpu < NR_CPUS; cpu++) {
+		while (!storm_done[cpu])
+			;
+		dmb(sy);
+		stats_merge(&stats, &storm_stats[cpu]);
+	}
+
+	/* Nobody may go down before all CPU_ON calls have been issued */
+	storm_over = 1;
+
+	print_stats("Concurrent CPU_ON", &stats);
+}
+
+/* Wait for all secondaries to be back down, and ready for CPU_ON */
+static void wait_secondaries_off(void)
+{
+	unsigned int cpu;
+
+	for (cpu = 1; cpu < NR_CPUS; cpu++)
+		while (psci_invoke(PSCI_AFFINITY_INFO_64, bench_id_table[cpu],
+				   0, 0) != PSCI_AFFINITY_OFF)
+			;
+}
+
+/* Time from start until the last secondary has arrived */
+static unsigned long wait_secondaries_on(unsigned long start)
+{
+	unsigned long last = start;
+	unsigned int cpu;
+
+	for (cpu = 1; cpu < NR_CPUS; cpu++) {
+		while (!arrived[cpu])
+			;
+		if (arrived[cpu] > last)
+			last = arrived[cpu];
+	}
+
+	return last - start;
+}
+
+static void bench_batch(void)
+{
+	struct bench_stats single_stats, batch_stats;
+	unsigned long start;
+	unsigned int cpu;
+	long ret;
+	int i;
+
+	stats_init(&single_stats);
+	stats_init(&batch_stats);
+	bench_mode = BENCH_BATCH;
+
+	for (i = 0; i < BENCH_CYCLE_ITERATIONS; i++) {
+		wait_secondaries_off();
+		for (cpu = 1; cpu < NR_CPUS; cpu++)
+			arrived[cpu] = 0;
+
+		start = read_counter();
+		for (cpu = 1; cpu < NR_CPUS; cpu++)
+			if (cpu_on(cpu) != PSCI_RET_SUCCESS)
+				print_cpu_warn(cpu, "CPU_ON failed\r\n");
+		stats_add(&single_stats, wait_secondaries_on(start));
+
+		wait_secondaries_off();
+		for (cpu = 1; cpu < NR_CPUS; cpu++)
+			arrived[cpu] = 0;
+
+		/* Level 3 only matches Aff3, which all CPUs share here */
+		start = read_counter();
+		ret = psci_invoke(SIP_CPU_ON_BATCH_64, bench_id_table[0],
+				  (unsigned long)secondary_entry, 3);
+		if (ret != NR_CPUS - 1) {
+			print_string("Batched CPU_ON failed\r\n");
+			return;
+		}
+		stats_add(&batch_stats, wait_secondaries_on(start));
+	}
+
+	print_stats("Bring-up with CPU_ON per CPU", &single_stats);
+	print_stats("Bring-up with batched CPU_ON", &batch_stats);
+}
+
+/*
+ * Identity map with 1GB blocks, Normal memory for the payload and Device
+ * memory for everything else, the console included.
+ */
+static bool mmu_prepare(void)
+{
+	extern char payload__start[], payload__end[];
+	unsigned long first = (unsigned long)payload__start >> BLOCK_SHIFT;
+	unsigned long last = ((unsigned long)payload__end - 1) >> BLOCK_SHIFT;
+	unsigned long i;
+
+	if (mrs(CurrentEL) != CURRENTEL_EL2 || last >= NR_BLOCKS)
+		return false;
+
+#ifdef UART_BASE
+	if ((UART_BASE >> BLOCK_SHIFT) >= first &&
+	    (UART_BASE >> BLOCK_SHIFT) <= last)
+		return false;
+#endif
+
+	for (i = 0; i < NR_BLOCKS; i++) {
+		unsigned long attrs = PTE_AF | PTE_BLOCK;
+
+		if (i >= first && i <= last)
+			attrs |= PTE_SH_INNER | PTE_ATTRINDX(ATTR_NORMAL);
+		else
+			attrs |= PTE_ATTRINDX(ATTR_DEVICE);
+
+		page_table[i] = (i << BLOCK_SHIFT) | attrs;
+	}
+
+	return true;
+}
+
+static void mmu_enable(void)
+{
+	msr(mair_el2, MAIR_ATTR_DEVICE_nGnRnE << (8 * ATTR_DEVICE) |
+		      MAIR_ATTR_NORMAL_WB << (8 * ATTR_NORMAL));
+	/* Non-cacheable walks: the table was written with the MMU off */
+	msr(tcr_el2, TCR_EL2_RES1 | TCR_EL2_T0SZ(VA_BITS) |
+		     mrs_field(ID_AA64MMFR0_EL1, PARANGE) << TCR_EL2_PS_SHIFT);
+	msr(ttbr0_el2, (unsigned long)page_table);
+	isb();
+	asm volatile ("tlbi alle2" : : : "memory");
+	iciallu();
+	dsb(nsh);
+	isb();
+
+	msr(sctlr_el2, mrs(sctlr_el2) | SCTLR_EL2_M | SCTLR_EL2_C | SCTLR_EL2_I);
+	isb();
+}
+
+static void lock_worker(unsigned int cpu)
+{
+	const struct bench_lock *lock = lock_round;
+	unsigned long count = 0;
+
+	/* Before reading anything the primary writes with the MMU on */
+	if (lock->mmu)
+		mmu_enable();
+
+	while (!lock_go)
+		;
+
+	while (read_counter() < lock_deadline) {
+		lock->acquire(cpu);
+		lock_counter = lock_counter + 1;
+		lock->release(cpu);
+		count++;
+	}
+
+	lock_count[cpu] = count;
+	dmb(sy);
+	lock_done[cpu] = 1;
+	dsb(sy);
+	sev();
+}
+
+static void bench_lock(const struct bench_lock *lock)
+{
+	unsigned long total = 0, min = ~0UL, max = 0, backoffs = 0;
+	unsigned int cpu;
+
+	wait_secondaries_off();
+
+	bench_mode = BENCH_LOCK;
+	lock_round = lock;
+	lock_go = 0;
+	lock_counter = 0;
+	for (cpu = 0; cpu < NR_CPUS; cpu++) {
+		arrived[cpu] = 0;
+		lock_done[cpu] = 0;
+		lock_backoffs[cpu] = 0;
+	}
+
+	if (lock->prepare)
+		lock->prepare();
+
+	for (cpu = 1; cpu < NR_CPUS; cpu++)
+		if (cpu_on(cpu) != PSCI_RET_SUCCESS)
+			print_cpu_warn(cpu, "CPU_ON failed\r\n");
+
+	/*
+	 * Secondaries write arrived[] with the MMU off: wait for them before
+	 * turning ours on, or we could keep reading a stale cached copy.
+	 */
+	wait_secondaries_on(0);
+
+	if (lock->mmu)
+		mmu_enable();
+
+	lock_deadline = read_counter() + BENCH_LOCK_TICKS;
+	dmb(sy);
+	lock_go = 1;
+
+	lock_worker(0);
+
+	for (cpu = 0; cpu < NR_CPUS; cpu++) {
+		while (!lock_done[cpu])
+			wfe();
+		dmb(sy);
+
+		total += lock_count[cpu];
+		backoffs += lock_backoffs[cpu];
+		if (lock_count[cpu] < min)
+			min = lock_count[cpu];
+		if (lock_count[cpu] > max)
+			max = lock_count[cpu];
+	}
+
+	print_string("Lock ");
+	print_string(lock->name);
+	print_string(": ");
+	print_ulong_dec(total);
+	print_string(" acquisitions in ");
+	print_ticks(BENCH_LOCK_TICKS);
+	print_string(" ticks, per CPU min ");
+	print_ulong_dec(min);
+	print_string(" max ");
+	print_ulong_dec(max);
+	if (backoffs) {
+		print_string(", ");
+		print_ulong_dec(backoffs);
+		print_string(" doorway back-offs");
+	}
+	print_string("\r\n");
+
+	/* Only expected to fail with a single CPU, which never contends */
+	if (lock->prepare && !backoffs)
+		print_string("Lock: doorway back-off not taken\r\n");
+
+	if (lock_counter != total)
+		print_string("Lock: mutual exclusion violated!\r\n");
+}
+
+static void bench_locks_all(void)
+{
+	unsigned int i;
+	bool mmu = mmu_prepare();
+
+	for (i = 0; i < NR_BENCH_LOCKS; i++) {
+		if (bench_locks[i].mmu && !mmu) {
+			print_string("Lock ");
+			print_string(bench_locks[i].name);
+			print_string(": needs Normal memory, skipped\r\n");
+			continue;
+		}
+
+		bench_lock(&bench_locks[i]);
+	}
+}
+
+void bench_secondary(unsigned int cpu)
+{
+	arrived[cpu] = read_counter();
+
+	if (bench_mode == BENCH_STORM) {
+		storm(cpu);
+		while (!storm_over)
+			;
+	} else if (bench_mode == BENCH_LOCK) {
+		lock_worker(cpu);
+	}
+
+	leaving[cpu] = read_counter();
+	psci_invoke(PSCI_CPU_OFF, 0, 0, 0);
+}
+
+void bench_main(void)
+{
+	print_string("\r\nPSCI benchmark: ");
+	print_uint_dec(NR_CPUS);
+	print_string(" CPUs, counter at ");
+	print_uint_dec(COUNTER_FREQ);
+	print_string("Hz\r\n");
+
+	bench_smc();
+	bench_cycle();
+	bench_storm();
+	bench_batch();
+	bench_locks_all();
+
+	print_string("PSCI benchmark done.\r\n");
+
+	psci_invoke(PSCI_SYSTEM_OFF, 0, 0, 0);
+}
@@ -66,6 +66,16 @@ sub get_text_offset
 	return $self->{text_offset};
 }
 
+# The memory the kernel needs from its load offset, including its BSS. Where
+# image_size is 0, only the file size is known.
+sub get_image_size
+{
+	my $self = shift;
+	my $file_size = shift;
+
+	return $self->{image_size} > $file_size ? $self->{image_size} : $file_size;
+}
+
 sub get_load_offset
 {
 	my $self = shift;
@@ -1,7 +1,12 @@
 #!/usr/bin/perl -w
 # Find CPU IDs
 #
-# Usage: ./$0 <DTB>
+# Usage: ./$0 [--boot-cpu <first|capacity|MPIDR>] <DTB>
+#
+#   --boot-cpu	CPU to list first, which becomes logical CPU 0 and boots the
+#		kernel: the first CPU of the DTB (default), the first CPU with
+#		the highest capacity-dmips-mhz, or the CPU with the given MPIDR.
+#		The others follow in DTB order.
 #
 # Copyright (C) 2014 ARM Limited. All rights reserved.
 #
@@ -10,9 +15,15 @@
 
 use warnings;
 use strict;
+no warnings "portable";
+
+use Getopt::Long;
 
 use FDT;
 
+my $boot_cpu = 'first';
+GetOptions('boot-cpu=s' => \$boot_cpu) or die("Invalid options");
+
 my $filename = shift;
 die("No filename provided") unless defined($filename);
 
@@ -26,7 +37,32 @@ my @cpus = $root->find_by_device_type('cpu');
 
 my @ids = map {
 	my ($addr, $size) = $_->get_untranslated_reg(0);
-	sprintf("0x%x", $addr);
+	$addr;
 } @cpus;
 
-printf("%s\n", join(',', @ids));
+my $boot = 0;
+if ($boot_cpu eq 'capacity') {
+	my @capacities = map {
+		my $prop = $_->get_property('capacity-dmips-mhz');
+		defined($prop) ? $prop->read_u32_idx(0) : undef;
+	} @cpus;
+
+	# As Linux does, ignore the capacities unless all CPUs have one
+	die("Not all CPUs have a capacity-dmips-mhz in '$filename'")
+		if (grep { !defined } @capacities);
+
+	for (my $i = 1; $i < @cpus; $i++) {
+		$boot = $i if ($capacities[$i] > $capacities[$boot]);
+	}
+} elsif ($boot_cpu ne 'first') {
+	die("Invalid boot CPU '$boot_cpu'") unless ($boot_cpu =~ /^(0x)?[0-9a-f]+$/i);
+
+	my $mpidr = oct($boot_cpu =~ /^0x/i ? $boot_cpu : "0x$boot_cpu");
+	($boot) = grep { $ids[$_] == $mpidr } 0 .. $#ids;
+	die(sprintf("No CPU with MPIDR 0x%x in '%s'", $mpidr, $filename))
+		unless defined($boot);
+}
+
+unshift(@ids, splice(@ids, $boot, 1));
+
+printf("%s\n", join(',', map { sprintf("0x%x", $_) } @ids));
@@ -1,7 +1,10 @@
 #!/usr/bin/perl -w
 # Find the start of physical memory
 #
-# Usage: ./$0 <DTB> 
+# Usage: ./$0 [--banks] <DTB>
+#
+# With --banks, print the base and size of every memory bank instead, as a
+# comma-separated list of pairs.
 #
 # Copyright (C) 2014 ARM Limited. All rights reserved.
 #
@@ -13,6 +16,12 @@ use strict;
 
 use FDT;
 
+my $banks = 0;
+if (defined($ARGV[0]) && $ARGV[0] eq '--banks') {
+	$banks = 1;
+	shift;
+}
+
 my $filename = shift;
 die("No filename provided") unless defined($filename);
 
@@ -24,6 +33,24 @@ my $root = $fdt->get_root();
 
 # We assume the memory nodes and their reg entries are ordered by address.
 my @mems = $root->find_by_device_type("memory");
+
+if ($banks) {
+	my @pairs;
+
+	for my $mem (@mems) {
+		for (my $idx = 0; ; $idx++) {
+			my ($addr, $size) = $mem->get_translated_reg($idx);
+			last unless (defined($addr) && defined($size));
+			next unless ($size);
+			push(@pairs, sprintf("0x%x,0x%x", $addr, $size));
+		}
+	}
+	die("Unable to find memory") unless (@pairs);
+
+	printf("%s\n", join(',', @pairs));
+	exit(0);
+}
+
 my $mem = shift @mems;
 die("Unable to find memory") unless defined($mem);
 
@@ -0,0 +1,209 @@
+#!/usr/bin/perl -w
+# Pack the payloads and the boot-wrapper's regions after PHYS_OFFSET
+#
+# Usage: ./$0 [options] <DTB>
+#
+#   --text-limit <size>		end of the boot-wrapper's text
+#   --kernel <Image>		AArch64 kernel, placed as its header requires
+#   --kernel-offset <offset>	or a kernel at a fixed offset...
+#   --kernel-size <size>	...of at most this size
+#   --bootlog <size>		boot log ring
+#   --smc-stats <size>		SMC statistics
+#   --xen <image>		Xen
+#   --initrd <file>		initrd
+#   --bss <size>		boot-wrapper's .bss and stacks
+#   --snapshot			SYSTEM_RESET snapshot, sized from the payloads
+#   --legacy			keep the DTB, Xen and the initrd at least at their
+#				historical offsets, for payloads that are only
+#				known at boot
+#   --max-addr <addr>		end of the addressable memory
+#
+# Regions are placed in this order, each 2MB aligned (64KB for the boot log
+# and SMC statistics) and within a DT memory bank. Regions other than the
+# kernel and the DTB move to the next bank when they don't fit.
+#
+# Prints <name>=<offset from PHYS_OFFSET> pairs, plus fdt_size and
+# snapshot_size, <name>_limit for the offset of whatever follows the kernel,
+# the DTB and the initrd, and end for the end of the last region.
+#
+# Copyright (C) 2026 ARM Limited. All rights reserved.
+#
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE.txt file.
+
+use warnings;
+use strict;
+no warnings "portable";
+
+use Getopt::Long;
+
+use AA64Image;
+use FDT;
+
+use constant {
+	SZ_64K => 0x10000,
+	SZ_1M => 0x100000,
+	SZ_2M => 0x200000,
+};
+
+my %opt = (
+	'text-limit' => 0,
+	'max-addr' => 0,
+);
+
+GetOptions(\%opt, 'text-limit=s', 'kernel=s', 'kernel-offset=s',
+	   'kernel-size=s', 'bootlog=s', 'smc-stats=s', 'xen=s', 'initrd=s',
+	   'bss=s', 'snapshot', 'legacy', 'max-addr=s')
+	or die("Invalid options");
+
+for my $key (keys %opt) {
+	$opt{$key} = oct($opt{$key}) if ($opt{$key} =~ /^0/);
+}
+
+my $filename = shift;
+die("No filename provided") unless defined($filename);
+
+open (my $fh, "<:raw", $filename) or die("Unable to open file '$filename'");
+
+my $fdt = FDT->parse($fh) or die("Unable to parse DTB");
+
+my @banks;
+for my $mem ($fdt->get_root()->find_by_device_type("memory")) {
+	for (my $idx = 0; ; $idx++) {
+		my ($addr, $size) = $mem->get_translated_reg($idx);
+		last unless (defined($addr) && defined($size));
+		push(@banks, [$addr, $addr + $size]) if ($size);
+	}
+}
+die("Unable to find memory") unless (@banks);
+@banks = sort { $a->[0] <=> $b->[0] } @banks;
+
+my $phys_offset = $banks[0][0];
+my $bank = 0;
+
+sub file_size
+{
+	my $path = shift;
+	my $size = -s $path;
+
+	die("Unable to find '$path'") unless defined($size);
+	return $size;
+}
+
+sub align
+{
+	my ($val, $align) = @_;
+
+	return ($val + $align - 1) & ~($align - 1);
+}
+
+my %out;
+my @order;
+my $cur = $opt{'text-limit'};
+
+# Place @size bytes at or after @min, and return the offset
+sub place
+{
+	my ($name, $size, $align, $min, $movable) = @_;
+	my $off = align($cur > $min ? $cur : $min, $align);
+
+	for (;;) {
+		my $end = $phys_offset + $off + $size;
+
+		last if ($end <= $banks[$bank][1]);
+
+		die(sprintf("%s: 0x%x bytes don't fit in the memory bank at 0x%x",
+			    $name, $size, $banks[$bank][0]))
+			unless ($movable && $bank + 1 < @banks);
+
+		$bank++;
+		$off = align($banks[$bank][0] - $phys_offset, $align);
+	}
+
+	die(sprintf("%s: ends above 0x%x", $name, $opt{'max-addr'}))
+		if ($opt{'max-addr'} && $phys_offset + $off + $size > $opt{'max-addr'});
+
+	$out{$name} = $off;
+	push(@order, $name);
+	$cur = $off + $size;
+
+	return $off;
+}
+
+# Offset of a region that must not move, checked against what precedes it
+sub place_at
+{
+	my ($name, $off, $size) = @_;
+
+	die(sprintf("%s at 0x%x overlaps the previous region, which ends at 0x%x",
+		    $name, $off, $cur))
+		if ($off < $cur);
+
+	return place($name, $size, 1, $off, 0);
+}
+
+my $kernel_size;
+if (defined($opt{kernel})) {
+	open(my $kfh, "<:raw", $opt{kernel})
+		or die("Unable to open file '$opt{kernel}'");
+	my $image = AA64Image->parse($kfh) or die("Unable to parse Image");
+
+	$kernel_size = $image->get_image_size(file_size($opt{kernel}));
+	place_at('kernel', $image->get_load_offset($cur), $kernel_size);
+} else {
+	die("No kernel provided") unless defined($opt{'kernel-offset'}) &&
+					 defined($opt{'kernel-size'});
+	$kernel_size = $opt{'kernel-size'};
+	place_at('kernel', $opt{'kernel-offset'}, $kernel_size);
+}
+
+place('bootlog', $opt{bootlog}, SZ_64K, 0, 1) if ($opt{bootlog});
+place('smc_stats', $opt{'smc-stats'}, SZ_64K, 0, 1) if ($opt{'smc-stats'});
+
+# Room for the nodes the boot-wrapper adds. Linux wants at most 2MB.
+my $dtb_size = align(file_size($filename) + SZ_64K, SZ_64K);
+die("The DTB would exceed 2MB") if ($dtb_size > SZ_2M);
+place('fdt', $dtb_size, SZ_2M, $opt{legacy} ? 0x08000000 : 0, 0);
+$out{fdt_size} = $dtb_size;
+
+my $xen_size = 0;
+if (defined($opt{xen})) {
+	$xen_size = file_size($opt{xen});
+
+	# An AArch64 Xen has an Image header, which accounts for its BSS
+	open(my $xfh, "<:raw", $opt{xen}) or die("Unable to open file '$opt{xen}'");
+	read($xfh, my $raw, 64) == 64 or die("Unable to read '$opt{xen}'");
+	my ($size, $magic) = (unpack("VVQ<Q<Q<Q<Q<Q<VV", $raw))[3, 8];
+	$xen_size = $size if ($magic == AA64Image::HEADER_MAGIC && $size > $xen_size);
+
+	place('xen', $xen_size, SZ_2M, $opt{legacy} ? 0x08200000 : 0, 1);
+}
+
+my $fs_size = 0;
+if (defined($opt{initrd})) {
+	$fs_size = file_size($opt{initrd});
+	place('fs', $fs_size, SZ_2M, $opt{legacy} ? 0x10000000 : 0, 1);
+}
+
+place('bss', $opt{bss}, SZ_2M, 0, 1) if ($opt{bss});
+
+if ($opt{snapshot}) {
+	# The payloads and the DT, plus the boot-wrapper's data
+	my $size = align($kernel_size + $dtb_size + $xen_size + $fs_size + SZ_1M,
+			 SZ_2M);
+
+	place('snapshot', $size, SZ_2M, 0, 1);
+	$out{snapshot_size} = $size;
+}
+
+for (my $i = 0; $i < @order; $i++) {
+	my $name = $order[$i];
+
+	next unless ($name eq 'kernel' || $name eq 'fdt' || $name eq 'fs');
+	$out{"${name}_limit"} = $i + 1 < @order ? $out{$order[$i + 1]} :
+			       $banks[$bank][1] - $phys_offset;
+}
+
+$out{end} = $cur;
+
+print(join(' ', map { sprintf("%s=0x%x", $_, $out{$_}) } sort keys %out), "\n");
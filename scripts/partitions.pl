@@ -0,0 +1,324 @@
+#!/usr/bin/perl -w
+# Lay out the kernels of the partitions, and describe them to the build
+#
+# Usage: ./$0 [--cpu-ids <MPIDRs>] <mode> <platform DTB> <partitions file>
+#
+#   --cpu-ids		the CPU_IDS of the build, in logical ID order. Defaults
+#			to the order of the platform DTB.
+#
+#   --layout <end>	print count=, cpus=, entries=, dtbs= and files= for the
+#			build,
+#			after checking that no partition's memory overlaps
+#			another's, or the boot-wrapper's up to <end>
+#   --lds		print the linker script sections of the payloads, and
+#			link each partition's files as partition<n>-Image and
+#			partition<n>-initrd in the current directory
+#   --dtb <n>		print the path of partition <n>'s DTB
+#   --dts <n>		print the DT additions for partition <n>. For partition
+#			0, delete the other partitions' CPUs and reserve their
+#			memory.
+#
+# Each line of the partitions file is "<Image> <DTB> [<initrd>]", relative
+# paths being relative to the file. It describes partition 1 onwards: partition
+# 0 is the main kernel. A partition owns the CPUs and memory of its DTB, and
+# its lowest CPU boots it. Its kernel, DTB and initrd are packed at the start
+# of its first memory bank.
+#
+# Only partition 0 can use SPIs. The GIC distributor is shared, and Linux's
+# GIC driver disables it and every SPI as it probes, whatever its DT describes:
+# each kernel that boots kills the SPIs of the partitions already running.
+# Routing SPIs with GICD_IROUTER doesn't survive that, so the other partitions'
+# DTs should only describe devices that don't need an SPI. SGIs and PPIs, the
+# timers included, are per CPU and unaffected.
+#
+# Copyright (C) 2026 ARM Limited. All rights reserved.
+#
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE.txt file.
+
+use warnings;
+use strict;
+no warnings "portable";
+
+use File::Basename;
+use File::Spec;
+use Getopt::Long;
+
+use AA64Image;
+use FDT;
+
+use constant {
+	SZ_64K => 0x10000,
+	SZ_2M => 0x200000,
+};
+
+my %opt;
+GetOptions(\%opt, 'cpu-ids=s', 'layout=s', 'lds', 'dtb=i', 'dts=i')
+	or die("Invalid options");
+
+my $platform = shift;
+my $filename = shift;
+die("No filename provided") unless defined($platform) && defined($filename);
+
+sub parse_dtb
+{
+	my $path = shift;
+
+	open(my $fh, "<:raw", $path) or die("Unable to open file '$path'");
+	my $fdt = FDT->parse($fh) or die("Unable to parse DTB '$path'");
+
+	return $fdt;
+}
+
+sub file_size
+{
+	my $path = shift;
+	my $size = -s $path;
+
+	die("Unable to find '$path'") unless defined($size);
+	return $size;
+}
+
+sub align
+{
+	my ($val, $align) = @_;
+
+	return ($val + $align - 1) & ~($align - 1);
+}
+
+sub cpu_ids
+{
+	my $fdt = shift;
+
+	return map {
+		my ($addr, $size) = $_->get_untranslated_reg(0);
+		$addr;
+	} $fdt->get_root()->find_by_device_type('cpu');
+}
+
+sub memory_banks
+{
+	my $fdt = shift;
+	my @banks;
+
+	for my $mem ($fdt->get_root()->find_by_device_type("memory")) {
+		for (my $idx = 0; ; $idx++) {
+			my ($addr, $size) = $mem->get_translated_reg($idx);
+			last unless (defined($addr) && defined($size));
+			push(@banks, [$addr, $addr + $size]) if ($size);
+		}
+	}
+
+	return sort { $a->[0] <=> $b->[0] } @banks;
+}
+
+my $platform_fdt = parse_dtb($platform);
+my %cpu_node;
+for my $cpu ($platform_fdt->get_root()->find_by_device_type('cpu')) {
+	my ($addr, $size) = $cpu->get_untranslated_reg(0);
+	$cpu_node{$addr} = $cpu;
+}
+
+my @ids = cpu_ids($platform_fdt);
+@ids = map { oct($_) } split(',', $opt{'cpu-ids'}) if (defined($opt{'cpu-ids'}));
+
+my %logical_id;
+for (my $i = 0; $i < @ids; $i++) {
+	die(sprintf("CPU 0x%x isn't in %s", $ids[$i], $platform))
+		unless (defined($cpu_node{$ids[$i]}));
+	$logical_id{$ids[$i]} = $i;
+}
+
+# Partition of each logical CPU, all in partition 0 to begin with
+my @cpu_partition = (0) x @ids;
+
+my @partitions;
+open(my $fh, "<", $filename) or die("Unable to open file '$filename'");
+while (my $line = <$fh>) {
+	$line =~ s/#.*//;
+	my @fields = split(' ', $line);
+	next unless (@fields);
+
+	die("$filename:$.: expected <Image> <DTB> [<initrd>]")
+		unless (@fields == 2 || @fields == 3);
+
+	@fields = map {
+		File::Spec->rel2abs($_, dirname(File::Spec->rel2abs($filename)))
+	} @fields;
+	my ($kernel, $dtb, $initrd) = @fields;
+	my $n = @partitions + 1;
+
+	my $fdt = parse_dtb($dtb);
+	my @cpus;
+	for my $id (cpu_ids($fdt)) {
+		my $cpu = $logical_id{$id};
+
+		die(sprintf("%s: CPU 0x%x isn't in %s", $dtb, $id, $platform))
+			unless defined($cpu);
+		die(sprintf("%s: CPU 0x%x boots the main kernel", $dtb, $id))
+			if ($cpu == 0);
+		die(sprintf("%s: CPU 0x%x is already in partition %d", $dtb, $id,
+			    $cpu_partition[$cpu]))
+			if ($cpu_partition[$cpu]);
+
+		$cpu_partition[$cpu] = $n;
+		push(@cpus, $cpu);
+	}
+	die("$dtb: no CPUs") unless (@cpus);
+
+	my @banks = memory_banks($fdt);
+	die("$dtb: no memory") unless (@banks);
+
+	open(my $kfh, "<:raw", $kernel) or die("Unable to open file '$kernel'");
+	my $image = AA64Image->parse($kfh) or die("Unable to parse Image '$kernel'");
+
+	# As scripts/layout.pl does, with nothing before the kernel
+	my $base = $banks[0][0];
+	my $kernel_off = $image->get_load_offset(0);
+	my $cur = $kernel_off + $image->get_image_size(file_size($kernel));
+
+	my $dtb_off = align($cur, SZ_2M);
+	my $dtb_size = align(file_size($dtb) + SZ_64K, SZ_64K);
+	$cur = $dtb_off + $dtb_size;
+
+	my ($fs_off, $fs_size);
+	if (defined($initrd)) {
+		$fs_off = align($cur, SZ_2M);
+		$fs_size = file_size($initrd);
+		$cur = $fs_off + $fs_size;
+	}
+
+	die(sprintf("%s: the payloads don't fit in the memory bank at 0x%x",
+		    $filename, $base))
+		if ($base + $cur > $banks[0][1]);
+
+	push(@partitions, {
+		kernel => $kernel,
+		dtb => $dtb,
+		initrd => $initrd,
+		fdt => $fdt,
+		cpus => \@cpus,
+		banks => \@banks,
+		entry => $base + $kernel_off,
+		dtb_addr => $base + $dtb_off,
+		dtb_size => $dtb_size,
+		fs_addr => defined($initrd) ? $base + $fs_off : undef,
+		fs_size => $fs_size,
+	});
+}
+close($fh);
+die("$filename: no partitions") unless (@partitions);
+
+sub overlaps
+{
+	my ($a, $b) = @_;
+
+	return $a->[0] < $b->[1] && $b->[0] < $a->[1];
+}
+
+sub reg_cells
+{
+	my ($addr, $size) = @_;
+
+	return sprintf("<0x%x 0x%x 0x%x 0x%x>", $addr >> 32, $addr & 0xffffffff,
+		       $size >> 32, $size & 0xffffffff);
+}
+
+if (defined($opt{layout})) {
+	my $phys_offset = (memory_banks($platform_fdt))[0][0];
+	my @taken = ([$phys_offset, oct($opt{layout}), "the boot-wrapper"]);
+
+	for (my $n = 1; $n <= @partitions; $n++) {
+		for my $bank (@{$partitions[$n - 1]{banks}}) {
+			for my $other (@taken) {
+				die(sprintf("Partition %d's memory at 0x%x overlaps %s",
+					    $n, $bank->[0], $other->[2]))
+					if (overlaps($bank, $other));
+			}
+			push(@taken, [@$bank, "partition $n"]);
+		}
+	}
+
+	printf("count=%d cpus=%s entries=%s dtbs=%s files=%s\n", @partitions + 1,
+	       join(',', @cpu_partition),
+	       join(',', map { sprintf("0x%x", $_->{entry}) } @partitions),
+	       join(',', map { sprintf("0x%x", $_->{dtb_addr}) } @partitions),
+	       join(':', map { grep { defined } @$_{qw(kernel dtb initrd)} } @partitions));
+} elsif ($opt{lds}) {
+	for (my $n = 1; $n <= @partitions; $n++) {
+		my $p = $partitions[$n - 1];
+
+		# Distinct names, so that a file shared by partitions is
+		# consumed once for each of them
+		unlink("partition$n-Image", "partition$n-initrd");
+		symlink($p->{kernel}, "partition$n-Image")
+			or die("Unable to link partition$n-Image");
+
+		printf("\t.kernel%d 0x%x: {\n\t\t\"partition%d-Image\"\n\t}\n\n",
+		       $n, $p->{entry}, $n);
+		printf("\t.dtb%d 0x%x: {\n\t\tdtb%d__start = .;\n" .
+		       "\t\t\"./partition%d.dtb\"\n\t\tdtb%d__end = .;\n\t}\n\n",
+		       $n, $p->{dtb_addr}, $n, $n, $n);
+		printf("\tASSERT(dtb%d__end <= dtb%d__start + 0x%x, \".dtb%d overflow!\")\n\n",
+		       $n, $n, $p->{dtb_size}, $n);
+
+		next unless defined($p->{initrd});
+
+		symlink($p->{initrd}, "partition$n-initrd")
+			or die("Unable to link partition$n-initrd");
+		printf("\t.filesystem%d 0x%x: {\n\t\t\"partition%d-initrd\"\n\t}\n\n",
+		       $n, $p->{fs_addr}, $n);
+	}
+} elsif (defined($opt{dtb})) {
+	my $n = $opt{dtb};
+
+	die("No partition $n") unless ($n >= 1 && $n <= @partitions);
+	print($partitions[$n - 1]{dtb}, "\n");
+} elsif (defined($opt{dts}) && $opt{dts} == 0) {
+	my @nodes;
+
+	for (my $n = 1; $n <= @partitions; $n++) {
+		for my $bank (@{$partitions[$n - 1]{banks}}) {
+			push(@nodes, sprintf("partition%d\@%x { reg = %s; no-map; };",
+					     $n, $bank->[0],
+					     reg_cells($bank->[0], $bank->[1] - $bank->[0])));
+		}
+	}
+	printf("/ { reserved-memory { #address-cells = <2>; #size-cells = <2>; ranges; %s }; };\n",
+	       join(' ', @nodes));
+
+	for (my $cpu = 0; $cpu < @cpu_partition; $cpu++) {
+		next unless ($cpu_partition[$cpu]);
+		printf("/delete-node/ &{%s};\n", $cpu_node{$ids[$cpu]}->get_full_path());
+	}
+
+	# Its phandles would point to deleted CPUs
+	for my $node (@{$platform_fdt->get_root()->{children}}) {
+		next unless ($node->{name} eq 'cpus');
+		for my $child (@{$node->{children}}) {
+			printf("/delete-node/ &{/cpus/cpu-map};\n")
+				if ($child->{name} eq 'cpu-map');
+		}
+	}
+} elsif (defined($opt{dts})) {
+	my $n = $opt{dts};
+
+	die("No partition $n") unless ($n >= 1 && $n <= @partitions);
+	my $p = $partitions[$n - 1];
+
+	if (defined($p->{initrd})) {
+		my $start = $p->{fs_addr};
+		my $end = $start + $p->{fs_size};
+
+		printf("/ { chosen { linux,initrd-start = <0x%x 0x%x>; " .
+		       "linux,initrd-end = <0x%x 0x%x>; }; };\n",
+		       $start >> 32, $start & 0xffffffff,
+		       $end >> 32, $end & 0xffffffff);
+	}
+
+	for my $cpu ($p->{fdt}->get_root()->find_by_device_type('cpu')) {
+		printf("&{%s} { enable-method = \"psci\"; };\n", $cpu->get_full_path());
+	}
+} else {
+	die("No mode given");
+}
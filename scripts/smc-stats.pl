@@ -0,0 +1,136 @@
+#!/usr/bin/perl -w
+# Decode the SMC statistics kept by the boot-wrapper
+#
+# Usage: ./$0 [--live] [--per-cpu] <dump>
+#
+# The dump is a copy of the region described by the DT's smc-stats node, for
+# example taken with:
+#
+#   dd if=/dev/mem of=dump bs=4096 skip=$((<base> / 4096)) count=<pages>
+#
+# By default the snapshot taken by the last SIP_SMC_STATS call is shown, with
+# --live the counters as they were when the dump was taken. See
+# common/smc_stats.c for the layout.
+#
+# Copyright (C) 2026 ARM Limited. All rights reserved.
+#
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE.txt file.
+
+use warnings;
+use strict;
+
+use constant {
+	MAGIC => 0x53434d53,
+	VERSION => 1,
+	HEADER_LEN => 48,
+	OTHER => 0xffffffff,
+};
+
+my %names = (
+	0x84000000 => 'PSCI_VERSION',
+	0x84000002 => 'PSCI_CPU_OFF',
+	0x84000003 => 'PSCI_CPU_ON_32',
+	0xc4000003 => 'PSCI_CPU_ON_64',
+	0x84000004 => 'PSCI_AFFINITY_INFO_32',
+	0xc4000004 => 'PSCI_AFFINITY_INFO_64',
+	0x84000006 => 'PSCI_MIGRATE_INFO_TYPE',
+	0x84000008 => 'PSCI_SYSTEM_OFF',
+	0x84000009 => 'PSCI_SYSTEM_RESET',
+	0x8400000a => 'PSCI_FEATURES',
+	0x84000012 => 'PSCI_SYSTEM_RESET2_32',
+	0xc4000012 => 'PSCI_SYSTEM_RESET2_64',
+	0x8200ff00 => 'SIP_SMC_STATS',
+	0x8200ff01 => 'SIP_CPU_ON_BATCH_32',
+	0xc200ff01 => 'SIP_CPU_ON_BATCH_64',
+	0x80000000 => 'SMCCC_VERSION',
+	0xc4000053 => 'TRNG_RND_64',
+	0xffffffff => 'other',
+);
+
+my ($live, $per_cpu) = (0, 0);
+while (@ARGV && $ARGV[0] =~ /^--/) {
+	my $opt = shift;
+	if ($opt eq '--live') {
+		$live = 1;
+	} elsif ($opt eq '--per-cpu') {
+		$per_cpu = 1;
+	} else {
+		die("Unknown option '$opt'");
+	}
+}
+
+my $filename = shift;
+die("No filename provided") unless defined($filename);
+
+open (my $fh, "<:raw", $filename) or die("Unable to open file '$filename'");
+my $raw = do { local $/; <$fh> };
+close($fh);
+
+die("Dump too short") if length($raw) < HEADER_LEN;
+
+my ($magic, $version, $nr_cpus, $nr_fids, $nr_buckets, $entry_size,
+    $freq, $snapshot_time, $reset_time) = unpack('V6 Q< Q< Q<', $raw);
+
+die(sprintf("Bad magic 0x%08x", $magic)) if $magic != MAGIC;
+die("Unsupported version $version") if $version != VERSION;
+
+my $table_len = $nr_cpus * $nr_fids * $entry_size;
+my $off = HEADER_LEN + ($live ? 0 : $table_len);
+die("Dump too short") if length($raw) < HEADER_LEN + 2 * $table_len;
+
+if (!$live && $snapshot_time == 0) {
+	print("No snapshot taken, use --live for the current counters\n");
+	exit(0);
+}
+
+printf("%s, %u CPUs, counter at %uHz", $live ? 'Live counters' : 'Snapshot',
+       $nr_cpus, $freq);
+printf(", %.3fs after reset", ($snapshot_time - $reset_time) / $freq) unless $live;
+print("\n");
+
+# fid => [count, timed, ticks, @hist]
+my (%total, @order);
+
+for my $cpu (0 .. $nr_cpus - 1) {
+	for my $idx (0 .. $nr_fids - 1) {
+		my $entry = substr($raw, $off, $entry_size);
+		$off += $entry_size;
+
+		my ($fid, undef, $count, $timed, $ticks, @hist) =
+			unpack("V V Q< Q< Q< Q<$nr_buckets", $entry);
+		next unless $count;
+
+		print_entry("CPU$cpu", $fid, $count, $timed, $ticks, @hist) if $per_cpu;
+
+		push(@order, $fid) unless exists($total{$fid});
+		$total{$fid} //= [ (0) x (3 + $nr_buckets) ];
+		my $t = $total{$fid};
+		$t->[0] += $count;
+		$t->[1] += $timed;
+		$t->[2] += $ticks;
+		$t->[3 + $_] += $hist[$_] for (0 .. $nr_buckets - 1);
+	}
+}
+
+print("No calls recorded\n") unless @order;
+print_entry('all', $_, @{$total{$_}}) for (@order);
+
+sub print_entry
+{
+	my ($who, $fid, $count, $timed, $ticks, @hist) = @_;
+	my $name = $names{$fid} // sprintf('0x%08x', $fid);
+
+	printf("%-4s %-22s %10u calls", $who, $name, $count);
+	if ($timed) {
+		printf(", avg %.0fns", $ticks * 1e9 / $timed / $freq);
+	}
+	print("\n");
+
+	for my $n (0 .. $#hist) {
+		next unless $hist[$n];
+		my $lo = $n ? 1 << ($n - 1) : 0;
+		my $hi = $n == $#hist ? '' : (1 << $n) - 1;
+		printf("\t%10s ticks: %u\n", "$lo-$hi", $hist[$n]);
+	}
+}